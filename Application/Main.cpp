@@ -32,6 +32,12 @@
 #include			"sBuildInfo.h"
 #include			"TWI.hpp"
 #include			"PTS.hpp"
+#include			"Scheduler.hpp"
+#include			"Payload.hpp"
+#include			"Auth.hpp"
+#include			"History.hpp"
+#include			"Timer.hpp"
+#include			"Power.hpp"
 
 #include 			"nrf_log.h"
 #include 			"nrf_log_ctrl.h"
@@ -49,31 +55,91 @@ __SBI(APP_NAME, APP_VERSION, APP_HW, "");
 
 // ----- ENUMS
 /**
- * @brief Enum class with application states.
+ * @brief Enum class with measurements done in single measure cycle.
  * 
  */
-enum class State_t : uint8_t
+enum class Measure_t : uint8_t
 {
-	Sleep = 0, /**< @brief Application sleep state. */
-	Measure, /**< @brief Application measure state. */
-	Advertise, /**< @brief Application advertise state. */
+	None = 0, /**< @brief No pending measurement. */
+	PTS = (1 << 0), /**< @brief Pressure and temperature measurement. */
+	ADC = (1 << 1), /**< @brief Battery voltage measurement. */
+};
+
+/**
+ * @brief Enum class with measure period governor modes.
+ * 
+ */
+enum class Mode_t : uint8_t
+{
+	Driving = 0, /**< @brief Vehicle is moving, measure every \ref AppConfig::measurePeriod */
+	Parked = 1, /**< @brief Pressure and temperature are stable, measure every \ref AppConfig::parkedPeriod */
+	Alarm = 2, /**< @brief Alarm is active, measure every \ref AppConfig::alarmMeasurePeriod */
 };
 
 
 // ----- VARIABLES
 Data::sTPMS sTPMSData = Data::sTPMS(); /**< @brief sTPMS data object. */
-static State_t state = State_t::Measure; /**< @brief Application state. */
-static uint8_t wakeupSet = 0; /**< @brief Wakeup timer flag. If set to \c 1 wakeup timer has started. */
 static uint8_t ledMeasureCount = 0; /**< @brief Measure counter for LED. */
 static uint8_t measureBattery = 0; /**< @brief Flag for measure battery with ADC. */
 static uint8_t adcNotInited = 0; /**< @brief Flag for not inited ADC. */
 static uint8_t advFailCnt = 0; /**< @brief BLE advertise fail counter. */
+static uint8_t measurePending = (uint8_t)Measure_t::None; /**< @brief Bitmap of pending measurements. See \ref Measure_t */
+static Data::sTPMS advData = Data::sTPMS(); /**< @brief Last advertised sTPMS data. */
+static Payload::Frame_t advFrame = Payload::Frame_t::Full; /**< @brief Frame type of encoded advertise payload. */
+static uint8_t advPayload[Payload::maxSize + Auth::size]; /**< @brief Encoded advertise payload with authentication trailer. Sized for full frame. */
+static uint8_t advLen = 0; /**< @brief Length of encoded advertise payload with authentication trailer. */
+static uint8_t advDiagCnt = 0; /**< @brief Number of advertises since last advertise with full frame. */
+static Data::sTPMS diagData = Data::sTPMS(); /**< @brief Data sent in last advertise with full frame. */
+static uint8_t scanPayload[Payload::getSize(Payload::Frame_t::Full) + Auth::size]; /**< @brief Encoded scan response payload with diagnostic fields and authentication trailer. */
+static uint8_t advSequence = 0; /**< @brief Advertise sequence number. */
+static uint8_t heartbeatDue = 0; /**< @brief Set to \c 1 when heartbeat advertise is due. */
+static constexpr uint8_t wakeupPeriod = AppConfig::measurePeriod; /**< @brief Wakeup timer period in seconds. */
+static uint8_t wakeupSeconds = wakeupPeriod; /**< @brief Period in seconds of running wakeup timer. */
+static uint32_t measureTick = 0; /**< @brief Timer tick at start of last measure cycle. */
+static uint32_t cycleTick = 0; /**< @brief Timer tick at end of last measure cycle. */
+static uint32_t alarmTick = 0; /**< @brief Timer tick of last alarm check. */
+static uint32_t uptimeTick = 0; /**< @brief Timer tick at start of current uptime hour. */
+static uint16_t alarmLastPressure = 0; /**< @brief Pressure in mbar from last measure cycle with valid pressure. */
+static uint8_t alarmCycles = 0; /**< @brief Number of measure cycles left in alarm burst and alarm measure period. */
+static uint8_t alarmLow = 0; /**< @brief Set to \c 1 while last valid pressure is below \ref AppConfig::alarmPressure */
+static uint8_t connAdvCnt = 0; /**< @brief Number of advertises since last connectable advertise. */
+static uint8_t connCycles = 0; /**< @brief Number of measure cycles with active connection. */
+static uint16_t storageCycles = 0; /**< @brief Number of consecutive measure cycles with ambient pressure. */
+static uint8_t mounted = 0; /**< @brief Set to \c 1 once pressure above \ref AppConfig::storagePressure was measured since boot. */
+static Mode_t mode = Mode_t::Driving; /**< @brief Measure period governor mode. See \ref Mode_t */
+static uint8_t stableCycles = 0; /**< @brief Number of consecutive measure cycles without motion. */
+static uint16_t governorPressure = 0; /**< @brief Pressure in mbar from last measure cycle checked by governor. */
+static int16_t governorTemperature = 0; /**< @brief Temperature in centi degrees Celsius from last measure cycle checked by governor. */
+static uint32_t governorTick = 0; /**< @brief Timer tick of last measure cycle checked by governor. */
+static_assert(AppConfig::parkedPeriod <= 155 && AppConfig::parkedPeriod >= AppConfig::measurePeriod, "Parked period must fit in config byte and be longer than measure period");
+static_assert((uint32_t)AppConfig::connAdvCount * AppConfig::connAdvInterval * 5 / 8 < (uint32_t)AppConfig::measurePeriod * 1000, "Connectable window must end before next measure cycle");
+static_assert((uint32_t)AppConfig::alarmAdvCount * AppConfig::alarmAdvInterval * 5 / 8 < (uint32_t)AppConfig::alarmMeasurePeriod * 1000, "Alarm advertise burst must end before next alarm measure cycle");
+static_assert(3 + 4 + Payload::maxSize + Auth::size <= 31, "Full frame with flags and manufacturer data header must fit in 31 byte legacy advertise");
+static_assert(!AppConfig::storageMode || Hardware::wakeLine || Hardware::resetLine, "Storage mode needs wake GPIO or pin reset to wake device from System OFF");
 
 
 // ----- STATIC FUNCTION DECLARATIONS
 static inline void ledInit(void);
 static inline void ledOn(void);
 static inline void ledOff(void);
+static inline uint8_t isLEDBlinkActive(void);
+static void measureDone(const Measure_t measurement);
+static void onWatchdog(void);
+static void onUptime(void);
+static void onBattery(void);
+static void onHeartbeat(void);
+static void onWakeup(void);
+static void onMeasure(void);
+static void onADCDone(void);
+static void onPTSReady(void);
+static void onAdvertise(void);
+static void onAdvertiseDone(void);
+static void encodePayload(void);
+static void checkAlarm(void);
+static void checkStorage(void);
+static void checkMotion(void);
+static void startWakeup(void);
+static uint32_t phaseDelay(const uint32_t period);
 
 
 // ----- FUNCTION DEFINITIONS
@@ -98,6 +164,19 @@ int main(void)
 	// Init device data and SRAM EEPROM
 	Data::init(sTPMSData);
 
+	// Init scheduler before any module which can post events
+	Scheduler::init();
+	Scheduler::subscribe(Scheduler::Event_t::Watchdog, onWatchdog);
+	Scheduler::subscribe(Scheduler::Event_t::Uptime, onUptime);
+	Scheduler::subscribe(Scheduler::Event_t::Battery, onBattery);
+	Scheduler::subscribe(Scheduler::Event_t::Heartbeat, onHeartbeat);
+	Scheduler::subscribe(Scheduler::Event_t::Wakeup, onWakeup);
+	Scheduler::subscribe(Scheduler::Event_t::Measure, onMeasure);
+	Scheduler::subscribe(Scheduler::Event_t::ADCDone, onADCDone);
+	Scheduler::subscribe(Scheduler::Event_t::PTSReady, onPTSReady);
+	Scheduler::subscribe(Scheduler::Event_t::Advertise, onAdvertise);
+	Scheduler::subscribe(Scheduler::Event_t::AdvertiseDone, onAdvertiseDone);
+
 	// Init system
 	if (System::init() != Return_t::OK)
 	{
@@ -105,13 +184,32 @@ int main(void)
 		System::reset(System::Reset_t::SystemInit);
 	}	
 
+	if (Timer::init() != Return_t::OK)
+	{
+		_PRINT_ERROR("Timer init fail\n");
+		System::reset(System::Reset_t::SystemInit);
+	}
+
 	// Init BLE module
-	if (BLE::init() != Return_t::OK)
+	encodePayload();
+	if (BLE::init(advPayload, advLen, scanPayload, sizeof(scanPayload)) != Return_t::OK)
 	{
 		_PRINT_ERROR("BLE init fail\n");
 		System::reset(System::Reset_t::BLEInit);
 	}
 
+	if (AppConfig::connPeriod && History::init() != Return_t::OK)
+	{
+		_PRINT_ERROR("History init fail\n");
+		System::reset(System::Reset_t::HistoryInit);
+	}
+
+	if (Auth::init() != Return_t::OK)
+	{
+		_PRINT_ERROR("Auth init fail\n");
+		System::reset(System::Reset_t::AuthInit);
+	}
+
 	if (TWI::init() != Return_t::OK)
 	{
 		_PRINT_ERROR("TWI init fail\n");
@@ -132,153 +230,35 @@ int main(void)
 	}
 	
 	sTPMSData.setReset(System::getResetReason(), Data::eeprom->rstCount);
+	if (System::getResetReason() == System::Reset_t::SystemOff)
+	{
+		_PRINTF_INFO("Storage exit(%lu)\n", Data::eeprom->storageCnt);
+	}
 	ledOff();
-	while (1)
+
+	// Start timers together so their deadlines line up and share wakeups
+	if (Data::eeprom->workingSeconds >= 3600)
 	{
-		switch (state)
-		{
-			case State_t::Measure:
-			{
-				// Measure battery every time in debug buiild
-				#ifdef DEBUG
-				measureBattery = 1;
-				#endif // DEBUG
-
-				// Try to init ADC if init failed on startup
-				if (adcNotInited)
-				{
-					if (ADC::init() != Return_t::OK)
-					{
-						adcNotInited = 1;
-						sTPMSData.setErrorCode(Data::Error_t::ADCInit);
-						_PRINT_ERROR("ADC init fail\n");
-					}
-					else
-					{
-						adcNotInited = 0;
-					}
-				}
-
-				_PRINT_INFO("--- MEASURE\n");		
-
-				// Turn on the LED
-				if (System::getResetReason() == System::Reset_t::Powerup)
-				{
-					if (ledMeasureCount < AppConfig::ledBlinkCount + 1) // + 1 because device will do first measure right after powerup
-					{
-						measureBattery = 1;
-						ledOn();
-					}
-				}
-
-				// Start battery measurment
-				if (measureBattery)
-				{
-					if (!adcNotInited)
-					{
-						ADC::measure();	
-					}
-					else // ADC is not inited
-					{
-						measureBattery = 0;
-					}	
-				}
-
-				// Measure PTS
-				if (PTS::measure() == Return_t::OK)
-				{
-					sTPMSData.setPressure(PTS::getPressure());
-					sTPMSData.setTemperature(PTS::getTemperature());
-				}
-				else
-				{
-					sTPMSData.setPressure(0);
-					sTPMSData.setTemperature(0);
-				}
-
-				// Check if ADC is done with battery measurment
-				if (measureBattery)
-				{
-					measureBattery = 0;
-					while (ADC::isDone() != Return_t::OK);
-					sTPMSData.setVoltage(ADC::getVoltage());	
-				}
-
-				// Turn off the LED
-				if (System::getResetReason() == System::Reset_t::Powerup)
-				{
-					if (ledMeasureCount < AppConfig::ledBlinkCount + 1) // + 1 because device will do first measure right after powerup
-					{
-						// Small delay
-						for (uint32_t i = 0; i < 0xFFF; i++)
-						{
-							(void)i;
-						}
-
-						ledOff();
-						ledMeasureCount++;
-					}
-				}
-
-				state = State_t::Advertise;
-				break;
-			}
+		Data::eeprom->workingSeconds = 0;
+	}
+	uptimeTick = Timer::getTick() - ((uint32_t)Data::eeprom->workingSeconds * Timer::tickRate);
+	cycleTick = Timer::getTick();
+	System::feedWatchdog();
+	Timer::start(Scheduler::Event_t::Watchdog, phaseDelay(AppConfig::measurePeriod * 1000UL), AppConfig::measurePeriod * 1000UL);
+	Timer::start(Scheduler::Event_t::Wakeup, phaseDelay(wakeupPeriod * 1000UL), wakeupPeriod * 1000UL);
+	Timer::start(Scheduler::Event_t::Battery, phaseDelay(AppConfig::batteryPeriod * 1000UL), AppConfig::batteryPeriod * 1000UL);
+	Timer::start(Scheduler::Event_t::Uptime, (3600UL - Data::eeprom->workingSeconds) * 1000, 3600UL * 1000);
 
-			case State_t::Advertise:
-			{
-				_PRINT_INFO("--- ADVERTISE\n");
-
-				// Advertise sTPMS data
-				if (BLE::advertise(&sTPMSData, sizeof(sTPMSData)) != Return_t::OK)
-				{
-					advFailCnt++;
-					if (advFailCnt > AppConfig::advMaxFails)
-					{
-						_PRINT_ERROR("BLE advertise fail reset\n");
-						System::reset(System::Reset_t::AdvFail);
-					}
-				}
-
-				// Feed the dog
-				System::feedWatchdog();
-
-				// Go to sleep
-				state = State_t::Sleep;
-				break;
-			}
+	// Do first measure right after powerup
+	Scheduler::post(Scheduler::Event_t::Measure);
 
-			default:
-			{
-				// Start wakeup timer if needed
-				if (!wakeupSet)
-				{
-					wakeupSet = 1;
-					System::startWakeupTimer(AppConfig::measurePeriod);
-				}
-
-				// Put device to sleep
-				System::sleep();
-
-				// Woken by RTC2
-				if (System::isWoken() == Return_t::OK)
-				{
-					wakeupSet = 0;
-					state = State_t::Measure;
-					sTPMSData.clearErrorCode();
-
-					// Increase working seconds and uptime if needed
-					Data::eeprom->workingSeconds += AppConfig::measurePeriod;
-					if (Data::eeprom->workingSeconds >= 3600)
-					{
-						Data::eeprom->workingSeconds = 0;
-						sTPMSData.increaseUptime();
-						measureBattery = 1;
-						_PRINT_INFO("Uptime++\n");
-					}
-				}					
-				break;
-			}
-		}	
+	while (1)
+	{
+		// Sleep until next event if there is nothing to do
+		if (Scheduler::run() != Return_t::OK)
+		{
+			Scheduler::idle();
+		}
 	}
 }
 
@@ -328,5 +308,583 @@ static inline void ledOff(void)
 	nrf_gpio_pin_write(NRF_GPIO_PIN_MAP(Hardware::ledPort, Hardware::ledPin), 1);	
 }
 
+/**
+ * @brief Check if LED should blink during current measure cycle.
+ * 
+ * @return \c 1 if LED blink is active, \c 0 otherwise.
+ */
+static inline uint8_t isLEDBlinkActive(void)
+{
+	// + 1 because device will do first measure right after powerup
+	return (System::getResetReason() == System::Reset_t::Powerup && ledMeasureCount < AppConfig::ledBlinkCount + 1);
+}
+
+/**
+ * @brief Mark measurement as done and advertise if all measurements are done.
+ * 
+ * @param measurement Finished measurement. See \ref Measure_t
+ * 
+ * @return No return value.
+ */
+static void measureDone(const Measure_t measurement)
+{
+	measurePending &= ~(uint8_t)measurement;
+	if (measurePending == (uint8_t)Measure_t::None)
+	{
+		Scheduler::post(Scheduler::Event_t::Advertise);
+	}
+}
+
+/**
+ * @brief Watchdog feed timer task.
+ * 
+ * Watchdog is fed only while measure cycles keep finishing. Cycle which did not finish one feed period after its wakeup period resets the device.
+ * 
+ * @return No return value.
+ */
+static void onWatchdog(void)
+{
+	const uint32_t elapsed = (Timer::getTick() - cycleTick) / Timer::tickRate;
+	if (elapsed > (uint32_t)wakeupSeconds + AppConfig::measurePeriod)
+	{
+		_PRINTF_ERROR("Measure cycle stuck for %lus\n", elapsed);
+		return;
+	}
+
+	System::feedWatchdog();
+}
+
+/**
+ * @brief Uptime timer task.
+ * 
+ * @return No return value.
+ */
+static void onUptime(void)
+{
+	uptimeTick += 3600UL * Timer::tickRate;
+	Data::eeprom->workingSeconds = 0;
+	sTPMSData.increaseUptime();
+	_PRINT_INFO("Uptime++\n");
+}
+
+/**
+ * @brief Battery measure timer task.
+ * 
+ * @return No return value.
+ */
+static void onBattery(void)
+{
+	measureBattery = 1;
+}
+
+/**
+ * @brief Heartbeat timer task.
+ * 
+ * Next measure cycle is advertised even if data did not change.
+ * 
+ * @return No return value.
+ */
+static void onHeartbeat(void)
+{
+	heartbeatDue = 1;
+}
+
+/**
+ * @brief Wakeup timer task.
+ * 
+ * @return No return value.
+ */
+static void onWakeup(void)
+{
+	sTPMSData.clearErrorCode();
+
+	// Keep working seconds in SRAM EEPROM so uptime hour survives reset
+	const uint32_t seconds = (Timer::getTick() - uptimeTick) / Timer::tickRate;
+	Data::eeprom->workingSeconds = (seconds < 3600) ? seconds : 3599;
+
+	Scheduler::post(Scheduler::Event_t::Measure);
+}
+
+/**
+ * @brief Measure task.
+ * 
+ * Starts pressure/temperature conversion and battery measurement at the same time.
+ * 
+ * @return No return value.
+ */
+static void onMeasure(void)
+{
+	// Wakeup and heartbeat timers run freely so measure cycle can still be in progress
+	if (measurePending != (uint8_t)Measure_t::None)
+	{
+		return;
+	}
+
+	// Measure battery every time in debug buiild
+	#ifdef DEBUG
+	measureBattery = 1;
+	#endif // DEBUG
+
+	// Try to init ADC if init failed on startup
+	if (adcNotInited)
+	{
+		if (ADC::init() != Return_t::OK)
+		{
+			adcNotInited = 1;
+			sTPMSData.setErrorCode(Data::Error_t::ADCInit);
+			_PRINT_ERROR("ADC init fail\n");
+		}
+		else
+		{
+			adcNotInited = 0;
+		}
+	}
+
+	_PRINT_INFO("--- MEASURE\n");		
+	measureTick = Timer::getTick();
+
+	// Turn on the LED
+	if (isLEDBlinkActive())
+	{
+		measureBattery = 1;
+		ledOn();
+	}
+
+	measurePending = (uint8_t)Measure_t::PTS;
+
+	// Start battery measurment, with ADC on radio it is armed on advertise
+	if (measureBattery && !AppConfig::adcOnRadio)
+	{
+		measureBattery = 0;
+		if (!adcNotInited)
+		{
+			measurePending |= (uint8_t)Measure_t::ADC;
+			ADC::measure();	
+		}
+	}
+
+	// Start PTS conversion
+	if (PTS::start() != Return_t::OK)
+	{
+		sTPMSData.setPressure(0);
+		sTPMSData.setTemperature(0);
+		measureDone(Measure_t::PTS);
+	}
+}
+
+/**
+ * @brief PTS conversion ready task.
+ * 
+ * @return No return value.
+ */
+static void onPTSReady(void)
+{
+	const Return_t ret = PTS::read();
+	if (ret == Return_t::Timeout)
+	{
+		// Conversion is not done yet, PTS will post ready event again
+		return;
+	}
+
+	if (ret == Return_t::OK)
+	{
+		sTPMSData.setPressure(PTS::getPressure());
+		sTPMSData.setTemperature(PTS::getTemperature());
+	}
+	else
+	{
+		sTPMSData.setPressure(0);
+		sTPMSData.setTemperature(0);
+	}
+
+	measureDone(Measure_t::PTS);
+}
+
+/**
+ * @brief ADC measurement done task.
+ * 
+ * @return No return value.
+ */
+static void onADCDone(void)
+{
+	sTPMSData.setVoltage(ADC::getVoltage());
+
+	// With ADC on radio measure cycle does not wait for battery voltage
+	if (measurePending & (uint8_t)Measure_t::ADC)
+	{
+		measureDone(Measure_t::ADC);
+	}
+}
+
+/**
+ * @brief Advertise task.
+ * 
+ * @return No return value.
+ */
+static void onAdvertise(void)
+{
+	checkAlarm();
+	checkMotion();
+	checkStorage();
+
+	// History service disconnects after stream, this is backstop if central does not read history
+	if (BLE::isConnected())
+	{
+		connCycles++;
+		if (connCycles > AppConfig::connMaxCycles)
+		{
+			_PRINT_INFO("Connection timeout\n");
+			BLE::disconnect();
+		}
+	}
+	else
+	{
+		connCycles = 0;
+	}
+
+	// Skip radio event if data did not change since last advertise
+	if (!heartbeatDue && !isLEDBlinkActive() && !alarmCycles && !sTPMSData.isChanged(advData))
+	{
+		Data::eeprom->advSkipped++;
+		_PRINTF_INFO("--- ADVERTISE SKIP(%lu sent, %lu skipped)\n", Data::eeprom->advSent, Data::eeprom->advSkipped);
+
+		onAdvertiseDone();
+		startWakeup();
+		return;
+	}
+
+	_PRINT_INFO("--- ADVERTISE\n");
+
+	// Advertise sTPMS data, alarm goes in burst and LED blink cycles go on all channels
+	BLE::Adv_t type = BLE::Adv_t::Normal;
+	if (alarmCycles)
+	{
+		type = BLE::Adv_t::Alarm;
+	}
+	else if (AppConfig::connPeriod && !BLE::isConnected() && connAdvCnt + 1 >= AppConfig::connPeriod)
+	{
+		type = BLE::Adv_t::Connectable;
+	}
+	else if (isLEDBlinkActive())
+	{
+		type = BLE::Adv_t::AllChannels;
+	}
+
+	// With ADC on radio first advertise packet samples battery under TX load, voltage goes into next advertise
+	const uint8_t adcArmed = AppConfig::adcOnRadio && measureBattery && !adcNotInited;
+	if (adcArmed)
+	{
+		measureBattery = 0;
+		ADC::arm();
+	}
+
+	encodePayload();
+	if (BLE::advertise(advPayload, advLen, scanPayload, sizeof(scanPayload), type) == Return_t::OK)
+	{
+		advData = sTPMSData;
+		if (advFrame == Payload::Frame_t::Full)
+		{
+			diagData = sTPMSData;
+			advDiagCnt = 0;
+		}
+		advDiagCnt = (advDiagCnt + 1) % AppConfig::advDiagPeriod;
+		heartbeatDue = 0;
+		advSequence = (advSequence + 1) & Payload::getMax(Payload::Field_t::Sequence);
+		Data::eeprom->advSent++;
+		connAdvCnt = (type == BLE::Adv_t::Connectable) ? 0 : (connAdvCnt + 1);
+
+		// Heartbeat deadline counts from start of this measure cycle so it lines up with wakeup timer
+		const uint32_t heartbeatPeriod = 1000UL * (AppConfig::advHeartbeat + 1) * wakeupSeconds;
+		const uint32_t elapsed = ((Timer::getTick() - measureTick) * 1000) / Timer::tickRate;
+		Timer::start(Scheduler::Event_t::Heartbeat, (elapsed < heartbeatPeriod) ? (heartbeatPeriod - elapsed) : 0, heartbeatPeriod);
+
+		// Count packets per channel to compare gateway reception rate with radio usage
+		const uint8_t channels = BLE::getChannels();
+		for (uint8_t i = 0; i < 3; i++)
+		{
+			if (channels & (1 << i))
+			{
+				Data::eeprom->advPackets[i] += (type == BLE::Adv_t::Alarm) ? AppConfig::alarmAdvCount : ((type == BLE::Adv_t::Connectable) ? AppConfig::connAdvCount : AppConfig::advCount);
+			}
+		}
+		_PRINTF_INFO("Channels 0x%X(%lu, %lu, %lu)\n", channels, Data::eeprom->advPackets[0], Data::eeprom->advPackets[1], Data::eeprom->advPackets[2]);
+	}
+	else
+	{
+		advFailCnt++;
+		if (advFailCnt > AppConfig::advMaxFails)
+		{
+			_PRINT_ERROR("BLE advertise fail reset\n");
+			System::reset(System::Reset_t::AdvFail);
+		}
+
+		// Battery is sampled on next advertise
+		if (adcArmed)
+		{
+			measureBattery = 1;
+		}
+
+		// There will be no advertise done event
+		onAdvertiseDone();
+	}
+
+	startWakeup();
+}
+
+/**
+ * @brief Advertise done task.
+ * 
+ * @return No return value.
+ */
+static void onAdvertiseDone(void)
+{
+	// Radio is idle, stop ADC if advertise did not sample battery
+	if (AppConfig::adcOnRadio)
+	{
+		ADC::disarm();
+	}
+
+	// Turn off the LED after advertise event instead of busy-wait delay
+	if (isLEDBlinkActive())
+	{
+		ledOff();
+		ledMeasureCount++;
+	}
+
+	Scheduler::report();
+	Power::report();
+
+	_PRINTF_INFO("TWI transfers %u\n", TWI::getTransferCount());
+	TWI::clearTransferCount();
+
+	// Enter storage mode after last advertise is sent
+	if (AppConfig::storageMode && storageCycles >= AppConfig::storageCycles && !BLE::isConnected())
+	{
+		Data::eeprom->storageCnt++;
+		_PRINTF_INFO("Storage enter(%lu)\n", Data::eeprom->storageCnt);
+
+		PTS::powerDown();
+		System::off();
+	}
+}
+
+/**
+ * @brief Encode sTPMS data into advertise and scan response payload.
+ * 
+ * Advertise carries full frame every \ref AppConfig::advDiagPeriod advertises and when diagnostic fields changed, measure frame otherwise.
+ * In legacy advertise mode scan response always carries full frame. Extended advertise has no scan response.
+ * 
+ * @return No return value.
+ */
+static void encodePayload(void)
+{
+	advFrame = (!advDiagCnt || sTPMSData.isDiagChanged(diagData)) ? Payload::Frame_t::Full : Payload::Frame_t::Measure;
+	const uint8_t len = Payload::encode(advPayload, sTPMSData, advFrame, advSequence);
+	Auth::sign(advPayload, len);
+	advLen = len + Auth::size;
+
+	if (AppConfig::advMode == AppConfig::AdvMode_t::Legacy)
+	{
+		Auth::sign(scanPayload, Payload::encode(scanPayload, sTPMSData, Payload::Frame_t::Full, advSequence));
+	}
+}
+
+/**
+ * @brief Raise or clear alarm from last measurement.
+ * 
+ * Alarm is raised when pressure falls below \ref AppConfig::alarmPressure or drops faster than \ref AppConfig::alarmDropRate.
+ * Alarm flag stays set while pressure is below \ref AppConfig::alarmPressure
+ * Alarm burst and alarm measure period end after \ref AppConfig::alarmHold measure cycles without new alarm condition.
+ * 
+ * @return No return value.
+ */
+static void checkAlarm(void)
+{
+	const uint16_t pressure = sTPMSData.getPressure();
+	const uint32_t ticks = measureTick - alarmTick;
+	uint8_t raise = 0;
+
+	// Zero pressure means failed measurement
+	if (pressure)
+	{
+		// Burst only when crossing absolute threshold so flat tire does not keep burst active forever
+		alarmLow = (pressure < AppConfig::alarmPressure);
+		raise = (alarmLow && (!alarmLastPressure || alarmLastPressure >= AppConfig::alarmPressure));
+
+		if (alarmLastPressure > pressure && ticks)
+		{
+			raise |= (((uint32_t)(alarmLastPressure - pressure) * 60 * Timer::tickRate) / ticks > AppConfig::alarmDropRate);
+		}
+
+		alarmLastPressure = pressure;
+		alarmTick = measureTick;
+	}
+
+	if (raise)
+	{
+		if (!alarmCycles)
+		{
+			Data::eeprom->alarmCnt++;
+			_PRINTF_INFO("Alarm raised(%lu)\n", Data::eeprom->alarmCnt);
+		}
+		alarmCycles = AppConfig::alarmHold;
+	}
+	else if (alarmCycles)
+	{
+		alarmCycles--;
+		if (!alarmCycles)
+		{
+			_PRINT_INFO("Alarm burst done\n");
+		}
+	}
+
+	sTPMSData.setAlarm(alarmLow || alarmCycles);
+}
+
+/**
+ * @brief Count measure cycles with ambient pressure for storage mode.
+ * 
+ * Device on shelf or unmounted tire measures ambient pressure. Alarm and failed measurement reset the count.
+ * Once device measured inflated tire it never counts, so tire which goes flat does not send device to storage.
+ * 
+ * @return No return value.
+ */
+static void checkStorage(void)
+{
+	const uint16_t pressure = sTPMSData.getPressure();
+
+	if (pressure >= AppConfig::storagePressure)
+	{
+		mounted = 1;
+	}
+
+	if (AppConfig::storageMode && !mounted && pressure && pressure < AppConfig::storagePressure && !alarmCycles)
+	{
+		if (storageCycles < AppConfig::storageCycles)
+		{
+			storageCycles++;
+		}
+	}
+	else
+	{
+		storageCycles = 0;
+	}
+}
+
+/**
+ * @brief Select measure period governor mode from last measurement.
+ * 
+ * Temperature rise faster than \ref AppConfig::driveTemperatureRate or pressure change over \ref AppConfig::drivePressureDelta
+ * between two measure cycles means vehicle is moving. Device is parked after \ref AppConfig::parkedCycles measure cycles without motion.
+ * Alarm overrides both modes.
+ * 
+ * @return No return value.
+ */
+static void checkMotion(void)
+{
+	const uint16_t pressure = sTPMSData.getPressure();
+	const int16_t temperature = sTPMSData.getTemperature();
+	uint8_t moving = 0;
+
+	// Zero pressure means failed measurement
+	if (pressure)
+	{
+		const uint32_t ticks = measureTick - governorTick;
+		if (governorPressure && ticks)
+		{
+			const uint16_t delta = (pressure > governorPressure) ? (pressure - governorPressure) : (governorPressure - pressure);
+			moving = (delta > AppConfig::drivePressureDelta);
+
+			if (temperature > governorTemperature)
+			{
+				moving |= (((uint32_t)(temperature - governorTemperature) * 60 * Timer::tickRate) / ticks > AppConfig::driveTemperatureRate);
+			}
+		}
+
+		governorPressure = pressure;
+		governorTemperature = temperature;
+		governorTick = measureTick;
+	}
+
+	if (moving)
+	{
+		stableCycles = 0;
+	}
+	else if (stableCycles < AppConfig::parkedCycles)
+	{
+		stableCycles++;
+	}
+
+	Mode_t next = Mode_t::Driving;
+	if (alarmCycles)
+	{
+		next = Mode_t::Alarm;
+	}
+	else if (stableCycles >= AppConfig::parkedCycles)
+	{
+		next = Mode_t::Parked;
+	}
+
+	if (next != mode)
+	{
+		mode = next;
+		_PRINTF_INFO("Governor mode %u\n", (uint8_t)mode);
+	}
+}
+
+/**
+ * @brief Set wakeup timer period for next cycle.
+ * 
+ * Wakeup period follows governor mode, see \ref Mode_t
+ * Periodic wakeup timer is restarted in phase with uptime hour and config in advertise is updated only when period changes.
+ * 
+ * @return No return value.
+ */
+static void startWakeup(void)
+{
+	cycleTick = Timer::getTick();
+
+	uint8_t period = wakeupPeriod;
+	if (mode == Mode_t::Alarm)
+	{
+		period = AppConfig::alarmMeasurePeriod;
+	}
+	else if (mode == Mode_t::Parked)
+	{
+		period = AppConfig::parkedPeriod;
+	}
+
+	if (period != wakeupSeconds)
+	{
+		wakeupSeconds = period;
+		Timer::start(Scheduler::Event_t::Wakeup, phaseDelay(wakeupSeconds * 1000UL), wakeupSeconds * 1000UL);
+
+		sTPMSData.setConfig(AppConfig::hwID, wakeupSeconds);
+	}
+}
+
+/**
+ * @brief Get delay until next multiple of period counted from start of uptime hour.
+ * 
+ * Timers started with this delay expire in the same wakeup as other timers whose periods divide one hour.
+ * 
+ * @param period Timer period in ms.
+ * 
+ * @return Delay in ms. Full \c period if current time is on period boundary.
+ */
+static uint32_t phaseDelay(const uint32_t period)
+{
+	const int32_t ticks = (int32_t)(Timer::getTick() - uptimeTick);
+	uint32_t elapsed = 0;
+
+	// Uptime timer may be late by few ticks
+	if (ticks > 0)
+	{
+		elapsed = ((uint32_t)ticks * 125) / (Timer::tickRate / 8);
+	}
+
+	return period - (elapsed % period);
+}
+
 
 // END WITH NEW LINE
@@ -28,6 +28,11 @@
 // ----- INCLUDE FILES
 #include			<stdint.h>
 
+// Untracked header with AUTH_KEY define, key can also be passed with AUTH_KEY make variable
+#if __has_include("AuthKey.hpp")
+#include			"AuthKey.hpp"
+#endif
+
 
 /**
  * @addtogroup ApplicationConfig 
@@ -58,23 +63,77 @@ namespace AppConfig
 		sTPMS1 = 1, /**< @brief Hardware ID for sTPMS1. */
 	};
 
+	/**
+	 * @brief Enum class for advertise modes.
+	 * 
+	 */
+	enum class AdvMode_t : uint8_t
+	{
+		Legacy = 0, /**< @brief Legacy scannable advertise on 1M PHY with diagnostic payload in scan response. */
+		Extended2M = 1, /**< @brief Extended non-scannable advertise with full payload on 2M secondary PHY. Needs Bluetooth 5 scanner. */
+		ExtendedCoded = 2, /**< @brief Extended non-scannable advertise on LE Coded PHY. Not supported by s132 and nRF52832. */
+	};
+
 
 	// ----- VARIABLES
 	static constexpr char deviceName[] = "sTPMS1"; /**< @brief Bluetooth device name. */
 	static constexpr int8_t advTXPower = 4; /**< @brief Bluetooth TX power for advertising role(-40, -20, -16, -12, -8, -4, 0, or 4dBm). */
+	static constexpr AdvMode_t advMode = AdvMode_t::Legacy; /**< @brief Advertise mode. See \ref AdvMode_t */
+	static constexpr uint8_t advChannels = 3; /**< @brief Number of primary advertise channels used per advertise event(1, 2 or 3). With less than 3 channels start channel rotates every advertise event. */
 	static constexpr uint8_t advCount = 1; /**< @brief Number of advertisment events before stopping advertise. */
 	static constexpr uint8_t advMaxFails = 2; /**< @brief Maximum number of BLE advertise fails. */
 	static constexpr uint8_t bleTag = 1; /**< @brief Bluetooth connection tag. */
 	static constexpr Hardware_t hwID = Hardware_t::sTPMS1; /**< @brief sTPMS hardware ID. */
 	static constexpr uint8_t rttChannel = 0; /**< @brief RTT channel ID for debug output. */
 	#ifdef DEBUG
-	static constexpr uint16_t measurePeriod = 5; /**< @brief Measure period in seconds for debug build. */
+	static constexpr uint16_t measurePeriod = 5; /**< @brief Measure period in seconds while driving for debug build. */
 	#else
-	static constexpr uint16_t measurePeriod = 15; /**< @brief Measure period in seconds for release build. */
+	static constexpr uint16_t measurePeriod = 15; /**< @brief Measure period in seconds while driving for release build. */
 	#endif // DEBUG
-	static constexpr uint8_t wdtTimeout = measurePeriod + 4; /**< @brief Watchdog timer timeout in seconds. */
+	static constexpr uint8_t ptsFIFO = 0; /**< @brief Set to \c 1 to let sensor collect pressure samples in its FIFO between measurements instead of one-shot measurement. Sensor then converts \ref ptsFIFORate times per second instead of once per measure cycle. */
+	static constexpr uint8_t ptsFIFORate = 1; /**< @brief Sensor sample rate in Hz in FIFO mode(1, 4 or 10Hz). */
+	static constexpr uint8_t ptsFIFODepth = 128; /**< @brief Number of samples sensor FIFO can hold. */
+	static constexpr uint16_t parkedPeriod = (!ptsFIFO || measurePeriod * 10 * ptsFIFORate <= ptsFIFODepth) ? (measurePeriod * 10) : ((ptsFIFODepth / ptsFIFORate / measurePeriod) * measurePeriod); /**< @brief Measure period in seconds while parked. Must fit in config byte(155s max). In FIFO mode it is capped to longest multiple of \ref measurePeriod whose samples fit in sensor FIFO. */
+	static constexpr uint8_t parkedCycles = 20; /**< @brief Number of measure cycles without motion before measure period is stretched to \ref parkedPeriod */
+	static constexpr uint16_t driveTemperatureRate = 50; /**< @brief Temperature rise in centi degrees Celsius per minute which indicates moving vehicle. */
+	static constexpr uint16_t drivePressureDelta = 15; /**< @brief Pressure change in mbar between two measure cycles which indicates moving vehicle. */
+	static constexpr uint8_t wdtTimeout = measurePeriod + 4; /**< @brief Watchdog timer timeout in seconds. Watchdog is fed from periodic timer every measure period. */
+	static constexpr uint16_t batteryPeriod = 3600; /**< @brief Battery voltage measure period in seconds. */
+	static constexpr uint16_t timerSlack = 10; /**< @brief Periodic timer which expires within this many ms of other timer shares its wakeup. */
+	static constexpr uint8_t storageMode = 0; /**< @brief Set to \c 1 to enter System OFF storage mode when device measures ambient pressure for \ref storageCycles measure cycles. Needs wake GPIO or pin reset and is never entered after inflated tire was measured since boot. */
+	static constexpr uint16_t storagePressure = 1200; /**< @brief Pressure in mbar below which device is considered not mounted on inflated tire. */
+	static constexpr uint16_t storageCycles = 240; /**< @brief Number of consecutive measure cycles below \ref storagePressure before storage mode is entered. */
 	static constexpr uint16_t bleMnfID = 0x3105; /**< @brief Manufacturer ID in BLE advertise packet. */
+	static constexpr uint8_t adcOnRadio = 1; /**< @brief Set to \c 1 to sample battery over PPI from \c RADIO \c ADDRESS event of first advertise packet, under TX load. Voltage is advertised in next advertise. Set to \c 0 to sample at start of measure cycle. */
 	static constexpr uint8_t ledBlinkCount = 3; /**< @brief Number of measurments where LED will blink if reset reason is powerup. */
+	static constexpr uint8_t historySize = 64; /**< @brief Number of pressure samples kept in SRAM EEPROM history. */
+	static constexpr uint8_t advDiagPeriod = 10; /**< @brief Every this many advertises carries full frame with diagnostic fields. First advertise after reset and advertise after diagnostic fields changed always do. */
+	static constexpr uint8_t advHeartbeat = 8; /**< @brief Advertise at least every this many measure cycles even if data did not change. */
+	static constexpr uint16_t advPressureDeadband = 20; /**< @brief Pressure change in mbar against last advertised pressure which is not advertised. */
+	static constexpr uint16_t advTemperatureDeadband = 100; /**< @brief Temperature change in centi degrees Celsius against last advertised temperature which is not advertised. */
+	static constexpr uint8_t advVoltageDeadband = 5; /**< @brief Battery voltage change in centivolts against last advertised voltage which is not advertised. */
+	static constexpr uint16_t alarmPressure = 2500; /**< @brief Pressure in mbar below which alarm is raised. */
+	static constexpr uint16_t alarmDropRate = 100; /**< @brief Pressure drop rate in mbar per minute above which alarm is raised. */
+	static constexpr uint8_t alarmMeasurePeriod = 1; /**< @brief Measure period in seconds while alarm is active. */
+	static constexpr uint8_t alarmHold = 30; /**< @brief Number of measure cycles without alarm condition before alarm is cleared. */
+	static constexpr uint8_t alarmAdvCount = 5; /**< @brief Number of advertise events in alarm burst. */
+	static constexpr uint16_t alarmAdvInterval = 160; /**< @brief Advertise interval in alarm burst in 0.625ms units. */
+	#ifdef CONN_PERIOD
+	static constexpr uint8_t connPeriod = CONN_PERIOD; /**< @brief Every this many advertises is connectable for history download. Set with \c CONN_PERIOD make variable, which also enables SoftDevice link. */
+	#else
+	static constexpr uint8_t connPeriod = 0; /**< @brief Connectable window is disabled, see \c CONN_PERIOD */
+	#endif // CONN_PERIOD
+	static constexpr uint8_t connAdvCount = 20; /**< @brief Number of advertise events in connectable window. */
+	static constexpr uint16_t connAdvInterval = 160; /**< @brief Advertise interval in connectable window in 0.625ms units. */
+	static constexpr uint8_t connMaxCycles = 2; /**< @brief Number of measure cycles after which connection is terminated by device. */
+	static constexpr uint8_t authPayload = 0; /**< @brief Set to \c 1 to append counter and AES-CMAC tag to advertise and scan response payload. */
+	static constexpr uint8_t authTagSize = 4; /**< @brief Size of truncated AES-CMAC tag in bytes(1 - 16). */
+	#ifdef AUTH_KEY
+	static constexpr uint8_t authKey[16] = { AUTH_KEY }; /**< @brief Fleet master key from build. Device key is derived from it and device MAC address. */
+	#else
+	static constexpr uint8_t authKey[16] = {}; /**< @brief Fleet master key is not set, see \c AUTH_KEY */
+	static_assert(!authPayload, "Authenticated payload needs fleet master key, define AUTH_KEY with make variable or in untracked Config/AuthKey.hpp");
+	#endif // AUTH_KEY
 };
 
 
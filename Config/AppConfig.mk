@@ -1,4 +1,18 @@
 
+######################################
+# APPLICATION-RELATED CONFIG
+######################################
+
+# SET TO 1 TO USE BLOCKING ILPS22QS BUS HANDLERS (DEFINES ILPS22QS_SYNC)
+PTS_SYNC ?= 0
+
+# EVERY THIS MANY ADVERTISES IS CONNECTABLE FOR HISTORY DOWNLOAD (0 TO DISABLE, OTHERWISE RAISES SOFTDEVICE RAM NEEDS)
+CONN_PERIOD ?= 0
+
+# FLEET MASTER KEY FOR AUTHENTICATED PAYLOAD AS 16 COMMA SEPARATED BYTES (FOR EXAMPLE 0x01,0x02,...), KEEP IT OUT OF REPO
+AUTH_KEY ?=
+
+
 ######################################
 # APPLICATION-RELATED FILE LIST
 ######################################
@@ -12,6 +26,11 @@ Modules/System.cpp \
 Modules/ADC.cpp \
 Modules/TWI.cpp \
 Modules/PTS.cpp \
+Modules/Scheduler.cpp \
+Modules/Timer.cpp \
+Modules/Power.cpp \
+Modules/Auth.cpp \
+Modules/History.cpp \
 
 # APPLICATION C TRANSLATION FILES
 APP_C_FILES = \
@@ -40,3 +59,21 @@ APP_INCLUDE_PATHS = \
 
 APP_DEFINES = \
 
+ifeq ($(PTS_SYNC), 1)
+APP_DEFINES += -DILPS22QS_SYNC
+endif
+
+ifneq ($(CONN_PERIOD), 0)
+APP_DEFINES += \
+-DCONN_PERIOD=$(CONN_PERIOD) \
+-DNRF_SDH_BLE_PERIPHERAL_LINK_COUNT=1 \
+-DNRF_SDH_BLE_TOTAL_LINK_COUNT=1 \
+-DNRF_SDH_BLE_GAP_DATA_LENGTH=251 \
+-DNRF_SDH_BLE_GATT_MAX_MTU_SIZE=247 \
+-DNRF_SDH_BLE_VS_UUID_COUNT=1
+endif
+
+ifneq ($(AUTH_KEY),)
+APP_DEFINES += -DAUTH_KEY=$(AUTH_KEY)
+endif
+
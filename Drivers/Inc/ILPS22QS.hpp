@@ -58,6 +58,11 @@
 #define ILPS22QS_SPI_WRITE_TIMEOUT				10 /**< @brief Timeout in ms for SPI write operations. Can be changed during compile. */
 #endif // ILPS22QS_SPI_WRITE_TIMEOUT
 
+/*
+	Define ILPS22QS_SYNC during compile if all bus handlers are blocking.
+	Semaphore and wait machinery is then removed from the driver.
+*/
+
 
 // ----- NAMESPACES
 /**
@@ -68,6 +73,8 @@ namespace ILPS22QS
 {
 	// ----- VARIABLES
 	static constexpr char version[] = "v1.0rc3"; /**< @brief Driver version string. */
+	static constexpr uint8_t fifoSampleSize = 3; /**< @brief Size of single FIFO sample in bytes. */
+	static constexpr uint8_t fifoDepth = 128; /**< @brief Number of samples FIFO can hold. */
 
 
 	// ----- DEBUG
@@ -215,6 +222,21 @@ namespace ILPS22QS
 	};
 
 
+	/**
+	 * @brief Enum class with FIFO mode values.
+	 * 
+	 */
+	enum class FIFOMode_t : uint8_t
+	{
+		Bypass = 0b000, /**< @brief FIFO disabled. */
+		FIFO = 0b001, /**< @brief Collect samples until FIFO is full. */
+		Continuous = 0b011, /**< @brief Collect samples continuously, oldest sample is overwritten when FIFO is full. */
+		Bypass2FIFO = 0b101,
+		Bypass2Continous = 0b110,
+		Continous2FIFO = 0b111
+	};
+
+
 	// ----- STRUCTS
 	/**
 	 * @brief Interrupt config struct.
@@ -274,6 +296,19 @@ namespace ILPS22QS
 		State_t addressIncrement; /**< @brief Enable or disable auto address increment. */
 	};
 
+	/**
+	 * @brief Struct for sensor config applied with single batched write.
+	 * 
+	 */
+	struct Config_s
+	{
+		DataOutputConfig_s dataOutput; /**< @brief Data output config. See \ref DataOutputConfig_s */
+		FilterConfig_s filter; /**< @brief Low-pass filter config. See \ref FilterConfig_s */
+		PressureScale_t pressureScale; /**< @brief Pressure scale. See \ref PressureScale_t */
+		DataUpdate_t dataUpdate; /**< @brief Data update config. See \ref DataUpdate_t */
+		State_t analogHub; /**< @brief Set to \c State_t::Disable to disable analog hub/Qvar. */
+	};
+
 	/**
 	 * @brief Struct for interrupt sources.
 	 * 
@@ -298,6 +333,39 @@ namespace ILPS22QS
 		uint8_t temperatureAvailable; /**< @brief If set to \c 1 temperature data is available. */
 	};
 
+	/**
+	 * @brief Struct for FIFO config.
+	 * 
+	 */
+	struct FIFOConfig_s
+	{
+		FIFOMode_t mode; /**< @brief FIFO mode. See \ref FIFOMode_t */
+		uint8_t watermark; /**< @brief FIFO watermark level (0 - 127). */
+		State_t stopOnWatermark; /**< @brief Stop collecting samples when watermark level is reached. */
+	};
+
+	/**
+	 * @brief Struct for FIFO status.
+	 * 
+	 */
+	struct FIFOStatus_s
+	{
+		uint8_t level; /**< @brief Number of unread samples in FIFO. */
+		uint8_t watermark; /**< @brief If set to \c 1 FIFO watermark level is reached. */
+		uint8_t overrun; /**< @brief If set to \c 1 at least one sample was overwritten. */
+		uint8_t full; /**< @brief If set to \c 1 FIFO is full. */
+	};
+
+	/**
+	 * @brief Struct for pressure and temperature sample.
+	 * 
+	 */
+	struct Sample_s
+	{
+		uint16_t pressure; /**< @brief Pressure in hPa/mbar. */
+		int16_t temperature; /**< @brief Temperature in configured scale and centidegrees. */
+	};
+
 
 	// ----- TYPEDEFS
 	/**
@@ -329,6 +397,35 @@ namespace ILPS22QS
 	 */
 	typedef Return_t (*I2CRW_f)(const uint8_t address, void* data, const uint8_t len, const uint8_t timeout);
 
+	/**
+	 * @brief Typedef for external handler for I2C write-then-read operation with repeated start condition.
+	 * 
+	 * @param address Slave 7-bit I2C address.
+	 * @param txData Pointer to output data.
+	 * @param txLen Length of \c txData in bytes.
+	 * @param rxData Pointer to input buffer for incoming data.
+	 * @param rxLen Length of \c rxData buffer(number of bytes to receive).
+	 * @param timeout Operation timeout in ms.
+	 * 
+	 * @return \c Return_t::NOK on fail.
+	 * @return \c Return_t::OK on success.
+	 */
+	typedef Return_t (*I2CWR_f)(const uint8_t address, const void* txData, const uint8_t txLen, void* rxData, const uint8_t rxLen, const uint8_t timeout);
+
+	/**
+	 * @brief Typedef for external handler for I2C list of write operations.
+	 * 
+	 * @param address Slave 7-bit I2C address.
+	 * @param list Pointer to array of write operations.
+	 * @param entryLen Length of single write operation in bytes.
+	 * @param count Number of write operations in \c list
+	 * @param timeout Operation timeout in ms.
+	 * 
+	 * @return \c Return_t::NOK on fail.
+	 * @return \c Return_t::OK on success.
+	 */
+	typedef Return_t (*I2CList_f)(const uint8_t address, const void* list, const uint8_t entryLen, const uint8_t count, const uint8_t timeout);
+
 	/**
 	 * @brief Typedef for external handler for SPI read/write operations.
 	 * 
@@ -378,8 +475,10 @@ namespace ILPS22QS
 		 * 
 		 * @return No return value.
 		 */
+		#ifndef ILPS22QS_SYNC
 		inline void takeSemaphore(void)
 		{
+			asyncStatus = Return_t::OK;
 			semaphore = Semaphore_t::Taken;
 
 			ILPS22QS_PRINTN("ILPS22QS ", 9);
@@ -391,15 +490,19 @@ namespace ILPS22QS
 		 * 
 		 * This is required if async read and write is used(eg., interrupt driven or DMA).
 		 * 
+		 * @param status Status of finished async operation. Optional.
+		 * 
 		 * @return No return value.
 		 */
-		inline void freeSemaphore(void)
+		inline void freeSemaphore(const Return_t status = Return_t::OK)
 		{
+			asyncStatus = status;
 			semaphore = Semaphore_t::Free;
 
 			ILPS22QS_PRINTN("ILPS22QS ", 9);
 			ILPS22QS_PRINTN("free\n", 5);
 		}	
+		#endif // ILPS22QS_SYNC
 
 		/**
 		 * @brief Init the sensor.
@@ -417,6 +520,9 @@ namespace ILPS22QS
 			ILPS22QS_PRINTF_INFO(version, sizeof(version) - 1);
 			ILPS22QS_PRINTF_INFO("\n", 1);
 
+			// Sensor could be power cycled since last init
+			invalidateShadow();
+
 			// Check interface object
 			if (interface.check() != Return_t::OK)
 			{
@@ -488,6 +594,64 @@ namespace ILPS22QS
 			return Return_t::OK;
 		}
 
+		/**
+		 * @brief Configure the sensor with single batched write.
+		 * 
+		 * Writes analog hub, control 2 and control 1 registers as one list of write operations, without read-modify-write.
+		 * 
+		 * @param config Reference to sensor config. See \ref Config_s
+		 * 
+		 * @return \c Return_t::NOK on fail.
+		 * @return \c Return_t::OK on success.
+		 */
+		Return_t configure(const Config_s& config)
+		{
+			uint8_t list[3][2];
+			uint8_t count = 0;
+
+			if (config.analogHub == State_t::Disable)
+			{
+				list[count][0] = (uint8_t)Register_t::AnalogHubDisable;
+				list[count][1] = 0;
+				count++;
+			}
+
+			list[count][0] = (uint8_t)Register_t::Control2;
+			list[count][1] =	((uint8_t)config.pressureScale << (uint8_t)Control2Bitmap_t::FullScale) |
+								((uint8_t)config.filter.discard << (uint8_t)Control2Bitmap_t::LowPassFilterConfig) |
+								((uint8_t)config.filter.filter << (uint8_t)Control2Bitmap_t::LowPassFilterEnable) |
+								((uint8_t)config.dataUpdate << (uint8_t)Control2Bitmap_t::BlockDataUpdate);
+			count++;
+
+			// Data output config is last since it can start continuous mode
+			list[count][0] = (uint8_t)Register_t::Control1;
+			list[count][1] = 	((uint8_t)config.dataOutput.average << (uint8_t)Control1Bitmap_t::Average) | 
+								((uint8_t)config.dataOutput.dataRate << (uint8_t)Control1Bitmap_t::OutputDataRate);
+			count++;
+
+			// List must stay valid until async write is done
+			if (interface.writeList(&list[0][0], sizeof(list[0]), count) != Return_t::OK || complete() != Return_t::OK)
+			{
+				ILPS22QS_PRINTN_ERROR("ILPS22QS ", 9);
+				ILPS22QS_PRINTN_ERROR("Configure fail\n", 15);
+				return Return_t::NOK;
+			}
+
+			// Update shadow cache with written control registers
+			for (uint8_t i = 0; i < count; i++)
+			{
+				if (list[i][0] != (uint8_t)Register_t::AnalogHubDisable)
+				{
+					updateShadow(list[i]);
+				}
+			}
+			pressureScale = config.pressureScale;
+
+			ILPS22QS_PRINTN_INFO("ILPS22QS ", 9);
+			ILPS22QS_PRINTF_INFO("Configured %02X %02X\n", list[count - 2][1], list[count - 1][1]);
+			return Return_t::OK;
+		}
+
 		/**
 		 * @brief Set interrupt config.
 		 * 
@@ -550,18 +714,12 @@ namespace ILPS22QS
 		{
 			// Calculate raw pressure value and set TX buffer
 			const uint16_t rawPressure = threshold * pressureScaleDivider[(uint8_t)getPressureScale()];
-			txBuffer[0] = (uint8_t)Register_t::PressureThresholdHigh;
-			txBuffer[1] = rawPressure >> 8;
-
-			if (writeRegister(txBuffer, 2) != Return_t::OK)
-			{
-				return Return_t::NOK;
-			}
-
 			txBuffer[0] = (uint8_t)Register_t::PressureThresholdLow;
 			txBuffer[1] = rawPressure & 0xFF;
+			txBuffer[2] = rawPressure >> 8;
 
-			if (writeRegister(txBuffer, 2) != Return_t::OK)
+			// Write low and high byte in single transfer
+			if (writeRegister(txBuffer, 3) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}	
@@ -581,25 +739,15 @@ namespace ILPS22QS
 		 */
 		Return_t getPressureInterruptThreshold(uint16_t& output)
 		{
-			uint16_t tmpOutput = 0;
-			uint8_t tmp = 0;
-
-			// Read high byte
-			if (readRegister(Register_t::PressureThresholdHigh, tmp) != Return_t::OK)
+			// Read low and high byte in single transfer
+			uint8_t tmp[2];
+			if (readRegister(Register_t::PressureThresholdLow, tmp, sizeof(tmp)) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
-			tmpOutput = tmp << 8;		
-
-			// Read low byte
-			if (readRegister(Register_t::PressureThresholdLow, tmp) != Return_t::OK)
-			{
-				return Return_t::NOK;
-			}
-			tmpOutput |= tmp;
 
 			// Convert to output unit
-			output = tmpOutput / pressureScaleDivider[(uint8_t)getPressureScale()];
+			output = ((tmp[1] << 8) | tmp[0]) / pressureScaleDivider[(uint8_t)getPressureScale()];
 			return Return_t::OK;
 		}
 
@@ -616,7 +764,7 @@ namespace ILPS22QS
 			// Read control 2 register
 			uint8_t tmp = 0;
 
-			if (readRegister(Register_t::Control2, tmp) != Return_t::OK)
+			if (readControl(Register_t::Control2, tmp) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
@@ -625,7 +773,7 @@ namespace ILPS22QS
 			txBuffer[1] = tmp & ~(1 << (uint8_t)Control2Bitmap_t::FullScale);
 			txBuffer[1] |= ((uint8_t)scale << (uint8_t)Control2Bitmap_t::FullScale);
 
-			if (writeRegister(txBuffer, 2) != Return_t::OK)
+			if (writeControl(txBuffer) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}	
@@ -687,7 +835,7 @@ namespace ILPS22QS
 
 			ILPS22QS_PRINTN_INFO("ILPS22QS ", 9);
 			ILPS22QS_PRINTF_INFO("DO cfg set to %02X\n", txBuffer[1]);
-			return writeRegister(txBuffer, 2);
+			return writeControl(txBuffer);
 		}
 
 		/**
@@ -701,7 +849,7 @@ namespace ILPS22QS
 		Return_t getDataOutputConfig(DataOutputConfig_s& config)
 		{
 			uint8_t tmp = 0;
-			if (readRegister(Register_t::Control1, tmp) != Return_t::OK)
+			if (readControl(Register_t::Control1, tmp) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
@@ -711,16 +859,41 @@ namespace ILPS22QS
 			return Return_t::OK;
 		}
 
+		/**
+		 * @brief Get one-shot conversion time for average selection.
+		 * 
+		 * Can be used to wait for new data with a timer instead of polling \ref getDataStatus over the bus.
+		 * 
+		 * @param average Average selection. See \ref Average_t
+		 * 
+		 * @return Conservative one-shot conversion time in ms.
+		 */
+		static constexpr uint8_t getConversionTime(const Average_t average)
+		{
+			switch (average)
+			{
+				case Average_t::Average4: return 3;
+				case Average_t::Average8: return 4;
+				case Average_t::Average16: return 6;
+				case Average_t::Average32: return 10;
+				case Average_t::Average64: return 18;
+				case Average_t::Average128: return 35;
+				default: return 135;
+			}
+		}
+
 		/**
 		 * @brief Start pressure and temperature measurment when the sensor is in power-down/one-shot mode.
 		 * 
+		 * Control 2 register is taken from shadow cache, so this is single register write once the cache is valid.
+		 * 
 		 * @return \c Return_t::NOK on fail.
 		 * @return \c Return_t::OK on success. 
 		 */
 		Return_t measure(void)
 		{
 			uint8_t tmp = 0;
-			if (readRegister(Register_t::Control2, tmp) != Return_t::OK)
+			if (readControl(Register_t::Control2, tmp) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
@@ -744,7 +917,7 @@ namespace ILPS22QS
 		Return_t setFilterConfig(const FilterConfig_s& config)
 		{
 			uint8_t tmp = 0;
-			if (readRegister(Register_t::Control2, tmp) != Return_t::OK)
+			if (readControl(Register_t::Control2, tmp) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
@@ -755,7 +928,7 @@ namespace ILPS22QS
 
 			ILPS22QS_PRINTN_INFO("ILPS22QS ", 9);
 			ILPS22QS_PRINTF_INFO("Filter cfg set to %02X\n", txBuffer[1]);
-			return writeRegister(txBuffer, 2);
+			return writeControl(txBuffer);
 		}
 
 		/**
@@ -769,7 +942,7 @@ namespace ILPS22QS
 		Return_t getFilterConfig(FilterConfig_s& config)
 		{
 			uint8_t tmp = 0;
-			if (readRegister(Register_t::Control2, tmp) != Return_t::OK)
+			if (readControl(Register_t::Control2, tmp) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
@@ -790,7 +963,7 @@ namespace ILPS22QS
 		Return_t setDataUpdateConfig(const DataUpdate_t update)
 		{
 			uint8_t tmp = 0;
-			if (readRegister(Register_t::Control2, tmp) != Return_t::OK)
+			if (readControl(Register_t::Control2, tmp) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
@@ -801,7 +974,7 @@ namespace ILPS22QS
 
 			ILPS22QS_PRINTN_INFO("ILPS22QS ", 9);
 			ILPS22QS_PRINTF_INFO("Data update config set to %02X\n", txBuffer[1]);
-			return writeRegister(txBuffer, 2);				
+			return writeControl(txBuffer);				
 		}
 
 		/**
@@ -815,7 +988,7 @@ namespace ILPS22QS
 		Return_t getDataUpdateConfig(DataUpdate_t& update)
 		{
 			uint8_t tmp = 0;
-			if (readRegister(Register_t::Control2, tmp) != Return_t::OK)
+			if (readControl(Register_t::Control2, tmp) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
@@ -833,7 +1006,7 @@ namespace ILPS22QS
 		Return_t reset(void)
 		{
 			uint8_t tmp = 0;
-			if (readRegister(Register_t::Control2, tmp) != Return_t::OK)
+			if (readControl(Register_t::Control2, tmp) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
@@ -843,6 +1016,9 @@ namespace ILPS22QS
 
 			ILPS22QS_PRINTN_INFO("ILPS22QS ", 9);
 			ILPS22QS_PRINTN_INFO("Reset\n", 6);
+
+			// Registers are back to default values
+			invalidateShadow();
 			return writeRegister(txBuffer, 2);	
 		}
 
@@ -855,7 +1031,7 @@ namespace ILPS22QS
 		Return_t reboot(void)
 		{
 			uint8_t tmp = 0;
-			if (readRegister(Register_t::Control2, tmp) != Return_t::OK)
+			if (readControl(Register_t::Control2, tmp) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
@@ -865,6 +1041,9 @@ namespace ILPS22QS
 
 			ILPS22QS_PRINTN_INFO("ILPS22QS ", 9);
 			ILPS22QS_PRINTN_INFO("Reboot\n", 7);
+
+			// Registers are reloaded from memory
+			invalidateShadow();
 			return writeRegister(txBuffer, 2);			
 		}
 
@@ -901,7 +1080,7 @@ namespace ILPS22QS
 
 			ILPS22QS_PRINTN_INFO("ILPS22QS ", 9);
 			ILPS22QS_PRINTF_INFO("AH cfg set to %02X\n", txBuffer[1]);
-			return writeRegister(txBuffer, 2);		 
+			return writeControl(txBuffer);		 
 		}
 
 		/**
@@ -915,7 +1094,7 @@ namespace ILPS22QS
 		Return_t getAnalogHubConfig(AnalogHubConfig_s& config)
 		{
 			uint8_t tmp = 0;
-			if (readRegister(Register_t::Control3, tmp) != Return_t::OK)
+			if (readControl(Register_t::Control3, tmp) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
@@ -936,18 +1115,13 @@ namespace ILPS22QS
 		 */
 		Return_t getReferencePressure(uint16_t& output)
 		{
-			uint8_t tmp = 0;
-			if (readRegister(Register_t::PressureReferenceHigh, tmp) != Return_t::OK)
+			// Read low and high byte in single transfer
+			uint8_t tmp[2];
+			if (readRegister(Register_t::PressureReferenceLow, tmp, sizeof(tmp)) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}		
-			output = tmp << 8;
-
-			if (readRegister(Register_t::PressureReferenceLow, tmp) != Return_t::OK)
-			{
-				return Return_t::NOK;
-			}	
-			output |= tmp;
+			output = (tmp[1] << 8) | tmp[0];
 
 			return Return_t::OK;	
 		}
@@ -962,16 +1136,11 @@ namespace ILPS22QS
 		 */
 		Return_t setPressureOffset(const int16_t offset)
 		{
-			txBuffer[0] = (uint8_t)Register_t::PressureOffsetHigh;
-			txBuffer[1] = offset >> 8;
-			if (writeRegister(txBuffer, 2) != Return_t::OK)
-			{
-				return Return_t::NOK;
-			}
-
+			// Write low and high byte in single transfer
 			txBuffer[0] = (uint8_t)Register_t::PressureOffsetLow;
-			txBuffer[1] = offset;
-			if (writeRegister(txBuffer, 2) != Return_t::OK)
+			txBuffer[1] = offset & 0xFF;
+			txBuffer[2] = offset >> 8;
+			if (writeRegister(txBuffer, 3) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
@@ -991,18 +1160,13 @@ namespace ILPS22QS
 		 */
 		Return_t getPressureOffset(int16_t& output)
 		{
-			uint8_t tmp = 0;
-			if (readRegister(Register_t::PressureOffsetHigh, tmp) != Return_t::OK)
+			// Read low and high byte in single transfer
+			uint8_t tmp[2];
+			if (readRegister(Register_t::PressureOffsetLow, tmp, sizeof(tmp)) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
-			output = tmp << 8;
-
-			if (readRegister(Register_t::PressureOffsetLow, tmp) != Return_t::OK)
-			{
-				return Return_t::NOK;
-			}
-			output |= tmp;	
+			output = (int16_t)((tmp[1] << 8) | tmp[0]);
 
 			return Return_t::OK;
 		}
@@ -1054,38 +1218,104 @@ namespace ILPS22QS
 		}
 
 		/**
-		 * @brief Get measured pressure.
+		 * @brief Set FIFO config.
 		 * 
-		 * @param output Reference to output for pressure in hPa/mbar.
+		 * FIFO collects pressure samples only, so output data rate other than \ref OutputDataRate_t::OneShot must be set.
+		 * 
+		 * @param config Reference to FIFO config. See \ref FIFOConfig_s
 		 * 
 		 * @return \c Return_t::NOK on fail.
-		 * @return \c Return_t::OK on success. 
+		 * @return \c Return_t::OK on success.
 		 */
-		Return_t getPressure(uint16_t& output)
+		Return_t setFIFOConfig(const FIFOConfig_s& config)
 		{
-			int32_t tmp = 0;
-			uint8_t reg = 0;
+			// FIFO control and watermark registers are written in single transfer
+			txBuffer[0] = (uint8_t)Register_t::ControlFIFO;
+			txBuffer[1] =	(((uint8_t)config.mode & FIFOModeMask) << (uint8_t)FIFOControlBitmap_t::Mode) |
+							((uint8_t)config.stopOnWatermark << (uint8_t)FIFOControlBitmap_t::WatermarkStop);
+			txBuffer[2] = config.watermark & FIFOWatermarkMask;
+
+			ILPS22QS_PRINTN_INFO("ILPS22QS ", 9);
+			ILPS22QS_PRINTF_INFO("FIFO cfg set to %02X %u\n", txBuffer[1], txBuffer[2]);
+			return writeRegister(txBuffer, 3);
+		}
 
-			if (readRegister(Register_t::PressureOutHigh, reg) != Return_t::OK)
+		/**
+		 * @brief Get FIFO status.
+		 * 
+		 * @param output Reference to output. See \ref FIFOStatus_s
+		 * 
+		 * @return \c Return_t::NOK on fail.
+		 * @return \c Return_t::OK on success.
+		 */
+		Return_t getFIFOStatus(FIFOStatus_s& output)
+		{
+			// Read both FIFO status registers in single transfer
+			uint8_t tmp[2];
+			if (readRegister(Register_t::FIFOStatus1, tmp, sizeof(tmp)) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
-			tmp = reg << 16;
 
-			if (readRegister(Register_t::PressureOutMid, reg) != Return_t::OK)
+			output.level = tmp[0];
+			output.full = (tmp[1] >> (uint8_t)FIFOStatus2Bitmap_t::FIFOFull) & 1;
+			output.overrun = (tmp[1] >> (uint8_t)FIFOStatus2Bitmap_t::FIFOOverrun) & 1;
+			output.watermark = (tmp[1] >> (uint8_t)FIFOStatus2Bitmap_t::FIFOWatermark) & 1;
+
+			return Return_t::OK;
+		}
+
+		/**
+		 * @brief Read pressure samples from FIFO.
+		 * 
+		 * All samples are read in single bus transfer since address rolls back to \ref Register_t::FIFOOutLow when FIFO is enabled.
+		 * 
+		 * @param output Pointer to output array for pressure samples in hPa/mbar. Oldest sample is first.
+		 * @param buffer Pointer to buffer for raw FIFO data. Must be at least \c count * \ref fifoSampleSize bytes long.
+		 * @param count Number of samples to read (up to 85). Use \ref getFIFOStatus to get number of unread samples.
+		 * 
+		 * @return \c Return_t::NOK on fail.
+		 * @return \c Return_t::OK on success.
+		 */
+		Return_t getFIFOData(uint16_t* output, uint8_t* buffer, const uint8_t count)
+		{
+			if (!count || count > (UINT8_MAX / fifoSampleSize))
 			{
 				return Return_t::NOK;
 			}
-			tmp |= reg << 8;	
 
-			if (readRegister(Register_t::PressureOutLow, reg) != Return_t::OK)
+			if (readRegister(Register_t::FIFOOutLow, buffer, count * fifoSampleSize) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
-			tmp |= reg;
 
-			static constexpr uint16_t scaleDivider[] = { 4096, 2048 };
-			output = tmp / scaleDivider[(uint8_t)getPressureScale()];
+			for (uint8_t i = 0; i < count; i++)
+			{
+				output[i] = decodePressure(&buffer[i * fifoSampleSize]);
+			}
+
+			ILPS22QS_PRINTN("ILPS22QS ", 9);
+			ILPS22QS_PRINTF("FIFO read %u\n", count);
+			return Return_t::OK;
+		}
+
+		/**
+		 * @brief Get measured pressure.
+		 * 
+		 * @param output Reference to output for pressure in hPa/mbar.
+		 * 
+		 * @return \c Return_t::NOK on fail.
+		 * @return \c Return_t::OK on success. 
+		 */
+		Return_t getPressure(uint16_t& output)
+		{
+			uint8_t tmp[3];
+			if (readRegister(Register_t::PressureOutLow, tmp, sizeof(tmp)) != Return_t::OK)
+			{
+				return Return_t::NOK;
+			}
+
+			output = decodePressure(tmp);
 
 			ILPS22QS_PRINTN("ILPS22QS ", 9);
 			ILPS22QS_PRINTF("Pressure %u\n", output);
@@ -1102,26 +1332,44 @@ namespace ILPS22QS
 		 */
 		Return_t getTemperature(int16_t& output)
 		{
-			int16_t tmp = 0;
-			uint8_t reg = 0;	
-
-			if (readRegister(Register_t::TemperatureOutHigh, reg) != Return_t::OK)
+			uint8_t tmp[2];
+			if (readRegister(Register_t::TemperatureOutLow, tmp, sizeof(tmp)) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
-			tmp = reg << 8;	
 
-			if (readRegister(Register_t::TemperatureOutLow, reg) != Return_t::OK)
+			output = decodeTemperature(tmp);
+
+			ILPS22QS_PRINTN("ILPS22QS ", 9);
+			ILPS22QS_PRINTF("Temperature %d\n", output);
+			return Return_t::OK;			
+		}
+
+		/**
+		 * @brief Get measured pressure and temperature.
+		 * 
+		 * Both values are read in single bus transfer using register address auto-increment(enabled by default).
+		 * 
+		 * @param output Reference to output. See \ref Sample_s
+		 * 
+		 * @return \c Return_t::NOK on fail.
+		 * @return \c Return_t::OK on success. 
+		 */
+		Return_t getSample(Sample_s& output)
+		{
+			// Registers from PressureOutLow to TemperatureOutHigh
+			uint8_t tmp[5];
+			if (readRegister(Register_t::PressureOutLow, tmp, sizeof(tmp)) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
-			tmp |= reg;	
 
-			output = convertTemperature(tmp);
+			output.pressure = decodePressure(&tmp[0]);
+			output.temperature = decodeTemperature(&tmp[3]);
 
 			ILPS22QS_PRINTN("ILPS22QS ", 9);
-			ILPS22QS_PRINTF("Temperature %d\n", output);
-			return Return_t::OK;			
+			ILPS22QS_PRINTF("Sample %u %d\n", output.pressure, output.temperature);
+			return Return_t::OK;
 		}
 
 
@@ -1147,7 +1395,7 @@ namespace ILPS22QS
 			PressureReferenceHigh = 0x17, /**< @brief Pressure reference (MSB)(R). */
 			I3CControl = 0x19, /**< @brief I3C control (R/W). */
 			PressureOffsetLow = 0x1A, /**< @brief Pressure offset (LSB)(R). */
-			PressureOffsetHigh = 0x1A, /**< @brief Pressure offset (MSB)(R). */
+			PressureOffsetHigh = 0x1B, /**< @brief Pressure offset (MSB)(R). */
 			InterruptSource = 0x24, /**< @brief Interrupt source for differential pressure (R). */
 			FIFOStatus1 = 0x25, /**< @brief FIFO status (R). */
 			FIFOStatus2 = 0x26, /**< @brief FIFO status (R). */
@@ -1284,20 +1532,8 @@ namespace ILPS22QS
 			TemperatureOverrun = 5 /**< @brief Temperature overrun. */
 		};
 
-		/**
-		 * @brief Enum class with FIFO mode values.
-		 * 
-		 */
-		enum class FIFOMode_t : uint8_t
-		{
-			Bypass = 0b000,
-			FIFO = 0b001,
-			Continuous = 0b011,
-			Bypass2FIFO = 0b101,
-			Bypass2Continous = 0b110,
-			Continous2FIFO = 0b111
-		};
 		static constexpr uint8_t FIFOModeMask = 0b111; /**< @brief Bit mask for FIFO mode. */
+		static constexpr uint8_t FIFOWatermarkMask = 0x7F; /**< @brief Bit mask for FIFO watermark level. */
 
 		/**
 		 * @brief Enum class with I3C bus periods.
@@ -1327,10 +1563,15 @@ namespace ILPS22QS
 		Delay_f delayHandler = nullptr; /**< @brief Pointer to external function for wait operations. */
 		Tick_f tickHandler = nullptr; /**< @brief Pointer to external function for retrieving tick. */
 
-		uint8_t txBuffer[2]; /**< @brief Buffer for outgoing data. */
+		uint8_t txBuffer[3]; /**< @brief Buffer for outgoing data. */
 		PressureScale_t pressureScale = PressureScale_t::Scale1260hPa; /**< @brief Pressure scale. */
 		TemperatureScale_t temperatureScale = TemperatureScale_t::Celsius; /**< @brief Output scale for temperature. */
-		Semaphore_t semaphore = Semaphore_t::Free; /**< @brief Bus process semaphore. */
+		uint8_t shadow[3]; /**< @brief Shadow cache for control registers from \ref Register_t::Control1 to \ref Register_t::Control3 */
+		uint8_t shadowValid = 0; /**< @brief Bitmap of valid \ref shadow entries. */
+		#ifndef ILPS22QS_SYNC
+		volatile Semaphore_t semaphore = Semaphore_t::Free; /**< @brief Bus process semaphore. */
+		volatile Return_t asyncStatus = Return_t::OK; /**< @brief Status of last async operation. */
+		#endif // ILPS22QS_SYNC
 
 
 		// ----- METHOD DEFINITIONS
@@ -1346,21 +1587,15 @@ namespace ILPS22QS
 		Return_t readRegister(const Register_t reg, uint8_t* output, const uint8_t len)
 		{
 			txBuffer[0] = (uint8_t)reg;
-			if (interface.write(txBuffer, 1) != Return_t::OK)
-			{
-				ILPS22QS_PRINTN_ERROR("ILPS22QS ", 9);
-				ILPS22QS_PRINTF_ERROR("Register %02X write fail\n", txBuffer[0]);
-				return Return_t::NOK;
-			}
-
-			if (interface.read(output, len) != Return_t::OK)
+			if (interface.writeRead(txBuffer, 1, output, len) != Return_t::OK)
 			{
 				ILPS22QS_PRINTN_ERROR("ILPS22QS ", 9);
 				ILPS22QS_PRINTF_ERROR("Register %02X read fail\n", txBuffer[0]);
 				return Return_t::NOK;
 			}
 
-			return Return_t::OK;
+			// Output must be valid on return even with async interface
+			return complete();
 		}	
 
 		/**
@@ -1404,11 +1639,89 @@ namespace ILPS22QS
 				ILPS22QS_PRINTF_ERROR("Register write %02X fail\n", input[1]);
 				return Return_t::NOK;
 			}
-
-			return Return_t::OK;
 			#else
-			return interface.write(input, len);
+			if (interface.write(input, len) != Return_t::OK)
+			{
+				return Return_t::NOK;
+			}
 			#endif // DEBUG_ILPS22QS_ERROR
+
+			// Input buffer is reused by next operation
+			return complete();
+		}
+
+		/**
+		 * @brief Read control register through shadow cache.
+		 * 
+		 * Bus is accessed only if cached value is not valid.
+		 * 
+		 * @param reg Control register. Must be \ref Register_t::Control1, \ref Register_t::Control2 or \ref Register_t::Control3
+		 * @param output Reference to output for register value.
+		 * 
+		 * @return \c Return_t::NOK on fail.
+		 * @return \c Return_t::OK on success.
+		 */
+		Return_t readControl(const Register_t reg, uint8_t& output)
+		{
+			const uint8_t idx = (uint8_t)reg - (uint8_t)Register_t::Control1;
+
+			if (!(shadowValid & (1 << idx)))
+			{
+				if (readRegister(reg, shadow[idx]) != Return_t::OK)
+				{
+					return Return_t::NOK;
+				}
+				shadowValid |= (1 << idx);
+			}
+
+			output = shadow[idx];
+			return Return_t::OK;
+		}
+
+		/**
+		 * @brief Write control register and update shadow cache.
+		 * 
+		 * @param input Pointer to register address and value.
+		 * 
+		 * @return \c Return_t::NOK on fail.
+		 * @return \c Return_t::OK on success.
+		 */
+		Return_t writeControl(const uint8_t* input)
+		{
+			if (writeRegister(input, 2) != Return_t::OK)
+			{
+				// Register content is unknown after failed write
+				shadowValid &= ~(1 << (input[0] - (uint8_t)Register_t::Control1));
+				return Return_t::NOK;
+			}
+
+			updateShadow(input);
+			return Return_t::OK;
+		}
+
+		/**
+		 * @brief Update shadow cache with written control register value.
+		 * 
+		 * @param input Pointer to register address and value.
+		 * 
+		 * @return No return value.
+		 */
+		inline void updateShadow(const uint8_t* input)
+		{
+			const uint8_t idx = input[0] - (uint8_t)Register_t::Control1;
+
+			shadow[idx] = input[1];
+			shadowValid |= (1 << idx);
+		}
+
+		/**
+		 * @brief Invalidate shadow cache.
+		 * 
+		 * @return No return value.
+		 */
+		inline void invalidateShadow(void)
+		{
+			shadowValid = 0;
 		}
 
 		/**
@@ -1454,7 +1767,7 @@ namespace ILPS22QS
 			// Read control 2 register
 			uint8_t tmp = 0;
 
-			if (readRegister(Register_t::Control2, tmp) != Return_t::OK)
+			if (readControl(Register_t::Control2, tmp) != Return_t::OK)
 			{
 				return Return_t::NOK;
 			}
@@ -1477,6 +1790,33 @@ namespace ILPS22QS
 			return Return_t::OK;
 		}
 
+		/**
+		 * @brief Decode raw pressure output.
+		 * 
+		 * @param raw Pointer to pressure output registers, LSB first.
+		 * 
+		 * @return Pressure in hPa/mbar.
+		 */
+		uint16_t decodePressure(const uint8_t* raw) const
+		{
+			static constexpr uint16_t scaleDivider[] = { 4096, 2048 };
+			const int32_t tmp = (raw[2] << 16) | (raw[1] << 8) | raw[0];
+
+			return tmp / scaleDivider[(uint8_t)getPressureScale()];
+		}
+
+		/**
+		 * @brief Decode raw temperature output.
+		 * 
+		 * @param raw Pointer to temperature output registers, LSB first.
+		 * 
+		 * @return Temperature in configured scale and centidegrees.
+		 */
+		int16_t decodeTemperature(const uint8_t* raw) const
+		{
+			return convertTemperature((int16_t)((raw[1] << 8) | raw[0]));
+		}
+
 		/**
 		 * @brief Convert temperature to configured scale.
 		 * 
@@ -1517,9 +1857,13 @@ namespace ILPS22QS
 			delayHandler = waitHandler;
 			tickHandler = tick;
 
+			#ifndef ILPS22QS_SYNC
 			semaphore = Semaphore_t::Free;
+			#endif // ILPS22QS_SYNC
 			temperatureScale = tempScale;
 			memset(txBuffer, 0, sizeof(txBuffer));
+			memset(shadow, 0, sizeof(shadow));
+			shadowValid = 0;
 		}
 
 		/**
@@ -1532,6 +1876,65 @@ namespace ILPS22QS
 
 		}
 
+		/**
+		 * @brief Call external wait handler.
+		 * 
+		 * Interface class can hide this method to bind wait handler during compile.
+		 * 
+		 * @param period Wait period in ms.
+		 * 
+		 * @return No return value.
+		 */
+		inline void delay(const uint32_t period) const
+		{
+			if (delayHandler)
+			{
+				delayHandler(period);
+			}
+		}
+
+		/**
+		 * @brief Get tick from external tick handler.
+		 * 
+		 * Interface class can hide this method to bind tick handler during compile.
+		 * 
+		 * @param output Reference to tick output.
+		 * 
+		 * @return \c Return_t::NOK if tick is not available.
+		 * @return \c Return_t::OK on success.
+		 */
+		inline Return_t getTick(uint32_t& output) const
+		{
+			if (!tickHandler)
+			{
+				return Return_t::NOK;
+			}
+
+			output = tickHandler();
+			return Return_t::OK;
+		}
+
+		#ifdef ILPS22QS_SYNC
+		/**
+		 * @brief Wait for free semaphore. Nothing to wait for with sync interface.
+		 * 
+		 * @return \c Return_t::OK
+		 */
+		inline Return_t wait(void) const
+		{
+			return Return_t::OK;
+		}
+
+		/**
+		 * @brief Wait for async operation to finish. Nothing to wait for with sync interface.
+		 * 
+		 * @return \c Return_t::OK
+		 */
+		inline Return_t complete(void) const
+		{
+			return Return_t::OK;
+		}
+		#else
 		/**
 		 * @brief Wait for free semaphore.
 		 * 
@@ -1540,26 +1943,20 @@ namespace ILPS22QS
 		 */
 		Return_t wait(void) const
 		{
-			// Get system tick if tick handler is provided
-			uint32_t tick = 0;
-			if (tickHandler)
-			{
-				tick = tickHandler();
-			}
+			// Get system tick if tick is available
+			uint32_t start = 0;
+			const Return_t tickAvailable = interface.getTick(start);
 
 			// Check for process semaphore
 			while (isSemaphoreFree() == Return_t::NOK)
 			{
-				// Call wait handler if provided
-				if (delayHandler)
-				{
-					delayHandler(1);
-				}
+				interface.delay(1);
 
-				// Check for timeout if tick handler is provided
-				if (tickHandler)
+				// Check for timeout if tick is available
+				uint32_t now = 0;
+				if (tickAvailable == Return_t::OK && interface.getTick(now) == Return_t::OK)
 				{
-					if ((tickHandler() - tick) > timeout)
+					if ((now - start) > timeout)
 					{
 						ILPS22QS_PRINTN_ERROR("ILPS22QS ", 9);
 						ILPS22QS_PRINTN_ERROR("Wait timeout\n", 13);
@@ -1571,6 +1968,25 @@ namespace ILPS22QS
 			return Return_t::OK;
 		}
 
+		/**
+		 * @brief Wait for async operation to finish and get its status.
+		 * 
+		 * Returns immediately if sync interface is used.
+		 * 
+		 * @return \c Return_t::NOK if async operation failed.
+		 * @return \c Return_t::Timeout if function timeouted.
+		 * @return \c Return_t::OK on success.
+		 */
+		Return_t complete(void) const
+		{
+			if (wait() != Return_t::OK)
+			{
+				return Return_t::Timeout;
+			}
+
+			return asyncStatus;
+		}
+
 		/**
 		 * @brief Check is semaphore free.
 		 * 
@@ -1586,6 +2002,7 @@ namespace ILPS22QS
 
 			return Return_t::NOK;
 		}
+		#endif // ILPS22QS_SYNC
 	};
 
 	/**
@@ -1606,17 +2023,22 @@ namespace ILPS22QS
 		 * @param tempScale Output temperature scale. Optional. See \ref TemperatureScale_t
 		 * @param waitHandler Pointer to external function for handling wait state. Optional.
 		 * @param tick Pointer to external function for fetching tick. Optional.
+		 * @param i2cWriteRead Pointer to external function for I2C write-then-read operation. Optional.
+		 * @param i2cList Pointer to external function for I2C list of write operations. Optional.
 		 * 
 		 * @return No return value.
 		 */	
 		I2C(const I2CRW_f i2cRead, const I2CRW_f i2cWrite,
 			const MSP_f mspInit = nullptr, const MSP_f mspDeinit = nullptr,
 			const TemperatureScale_t tempScale = TemperatureScale_t::Celsius,
-			const Delay_f waitHandler = nullptr, const Tick_f tick = nullptr) :
+			const Delay_f waitHandler = nullptr, const Tick_f tick = nullptr,
+			const I2CWR_f i2cWriteRead = nullptr, const I2CList_f i2cList = nullptr) :
 			Driver<I2C>(mspInit, mspDeinit, tempScale, waitHandler, tick)
 		{
 			readHandler = i2cRead;
 			writeHandler = i2cWrite;
+			writeReadHandler = i2cWriteRead;
+			listHandler = i2cList;
 		}
 
 		/**
@@ -1669,6 +2091,76 @@ namespace ILPS22QS
 			return writeHandler(address, (void*)data, len, writeTimeout);
 		}
 
+		/**
+		 * @brief Write to and then read from sensor.
+		 * 
+		 * Uses repeated start condition if write-then-read handler is provided, otherwise falls back to separate write and read.
+		 * 
+		 * @param txData Pointer to data to write to the sensor.
+		 * @param txLen Size of \c txData buffer.
+		 * @param rxData Pointer to output buffer for data from the sensor.
+		 * @param rxLen Size of \c rxData buffer.
+		 * 
+		 * @return \c Return_t::NOK on fail.
+		 * @return \c Return_t::Timeout on timeout.
+		 * @return \c Return_t::OK on success.
+		 */
+		Return_t writeRead(const uint8_t* txData, const uint8_t txLen, uint8_t* rxData, const uint8_t rxLen) const
+		{
+			if (!writeReadHandler)
+			{
+				if (write(txData, txLen) != Return_t::OK || complete() != Return_t::OK)
+				{
+					return Return_t::NOK;
+				}
+
+				return read(rxData, rxLen);
+			}
+
+			if (wait() != Return_t::OK)
+			{
+				return Return_t::Timeout;
+			}
+
+			return writeReadHandler(address, txData, txLen, rxData, rxLen, readTimeout);
+		}
+
+		/**
+		 * @brief Write list of operations to sensor.
+		 * 
+		 * Uses list handler if provided, otherwise falls back to separate writes.
+		 * 
+		 * @param list Pointer to array of write operations.
+		 * @param entryLen Length of single write operation.
+		 * @param count Number of write operations in \c list
+		 * 
+		 * @return \c Return_t::NOK on fail.
+		 * @return \c Return_t::Timeout on timeout.
+		 * @return \c Return_t::OK on success.
+		 */
+		Return_t writeList(const uint8_t* list, const uint8_t entryLen, const uint8_t count) const
+		{
+			if (!listHandler)
+			{
+				for (uint8_t i = 0; i < count; i++)
+				{
+					if (write(&list[i * entryLen], entryLen) != Return_t::OK || complete() != Return_t::OK)
+					{
+						return Return_t::NOK;
+					}
+				}
+
+				return Return_t::OK;
+			}
+
+			if (wait() != Return_t::OK)
+			{
+				return Return_t::Timeout;
+			}
+
+			return listHandler(address, list, entryLen, count, writeTimeout);
+		}
+
 		/**
 		 * @brief Check I2C interface handlers.
 		 * 
@@ -1692,6 +2184,165 @@ namespace ILPS22QS
 
 		I2CRW_f readHandler = nullptr; /**< @brief Pointer to external function for I2C read. */
 		I2CRW_f writeHandler = nullptr; /**< @brief Pointer to external function for I2C write. */
+		I2CWR_f writeReadHandler = nullptr; /**< @brief Pointer to external function for I2C write-then-read. */
+		I2CList_f listHandler = nullptr; /**< @brief Pointer to external function for I2C list of writes. */
+	};
+
+	/**
+	 * @brief Class for ILPS22QS I2C operations with bus bound during compile.
+	 * 
+	 * Same as \ref I2C but handlers are static methods of \c Bus policy class, so compiler can inline whole register access path.
+	 * 
+	 * \c Bus must provide following static methods:
+	 * - \c read, \c write with \ref I2CRW_f signature
+	 * - \c writeRead with \ref I2CWR_f signature
+	 * - \c writeList with \ref I2CList_f signature
+	 * - \c mspInit, \c mspDeinit with \ref MSP_f signature
+	 * - \c delay with \ref Delay_f signature
+	 * - \c Return_t \c getTick(uint32_t& output) returning \c Return_t::NOK if tick is not available
+	 * 
+	 * @tparam Bus Policy class with bus handlers.
+	 */
+	template<class Bus>
+	class I2CBus : public Driver<I2CBus<Bus>>
+	{
+		public:
+		// ----- METHOD DEFINITIONS
+		/**
+		 * @brief Object constructor.
+		 * 
+		 * @param tempScale Output temperature scale. Optional. See \ref TemperatureScale_t
+		 * 
+		 * @return No return value.
+		 */
+		I2CBus(const TemperatureScale_t tempScale = TemperatureScale_t::Celsius) :
+			Driver<I2CBus<Bus>>(Bus::mspInit, Bus::mspDeinit, tempScale, nullptr, nullptr)
+		{
+
+		}
+
+		/**
+		 * @brief Read from sensor.
+		 * 
+		 * @param data Pointer to output buffer for data from the sensor.
+		 * @param len Size of \c data buffer.
+		 * 
+		 * @return \c Return_t::NOK on fail.
+		 * @return \c Return_t::Timeout on timeout.
+		 * @return \c Return_t::OK on success.
+		 */
+		inline Return_t read(uint8_t* data, const uint8_t len) const
+		{
+			if (this->wait() != Return_t::OK)
+			{
+				return Return_t::Timeout;
+			}
+
+			return Bus::read(address, data, len, readTimeout);
+		}
+
+		/**
+		 * @brief Write to sensor.
+		 * 
+		 * @param data Pointer to data to write to the sensor.
+		 * @param len Size of \c data buffer.
+		 * 
+		 * @return \c Return_t::NOK on fail.
+		 * @return \c Return_t::Timeout on timeout.
+		 * @return \c Return_t::OK on success.
+		 */
+		inline Return_t write(const uint8_t* data, const uint8_t len) const
+		{
+			if (this->wait() != Return_t::OK)
+			{
+				return Return_t::Timeout;
+			}
+
+			return Bus::write(address, (void*)data, len, writeTimeout);
+		}
+
+		/**
+		 * @brief Write to and then read from sensor with repeated start condition.
+		 * 
+		 * @param txData Pointer to data to write to the sensor.
+		 * @param txLen Size of \c txData buffer.
+		 * @param rxData Pointer to output buffer for data from the sensor.
+		 * @param rxLen Size of \c rxData buffer.
+		 * 
+		 * @return \c Return_t::NOK on fail.
+		 * @return \c Return_t::Timeout on timeout.
+		 * @return \c Return_t::OK on success.
+		 */
+		inline Return_t writeRead(const uint8_t* txData, const uint8_t txLen, uint8_t* rxData, const uint8_t rxLen) const
+		{
+			if (this->wait() != Return_t::OK)
+			{
+				return Return_t::Timeout;
+			}
+
+			return Bus::writeRead(address, txData, txLen, rxData, rxLen, readTimeout);
+		}
+
+		/**
+		 * @brief Write list of operations to sensor.
+		 * 
+		 * @param list Pointer to array of write operations.
+		 * @param entryLen Length of single write operation.
+		 * @param count Number of write operations in \c list
+		 * 
+		 * @return \c Return_t::NOK on fail.
+		 * @return \c Return_t::Timeout on timeout.
+		 * @return \c Return_t::OK on success.
+		 */
+		inline Return_t writeList(const uint8_t* list, const uint8_t entryLen, const uint8_t count) const
+		{
+			if (this->wait() != Return_t::OK)
+			{
+				return Return_t::Timeout;
+			}
+
+			return Bus::writeList(address, list, entryLen, count, writeTimeout);
+		}
+
+		/**
+		 * @brief Check I2C interface handlers. Handlers are checked during compile.
+		 * 
+		 * @return \c Return_t::OK
+		 */
+		inline Return_t check(void) const
+		{
+			return Return_t::OK;
+		}
+
+		/**
+		 * @brief Call bus wait handler.
+		 * 
+		 * @param period Wait period in ms.
+		 * 
+		 * @return No return value.
+		 */
+		static inline void delay(const uint32_t period)
+		{
+			Bus::delay(period);
+		}
+
+		/**
+		 * @brief Get tick from bus tick handler.
+		 * 
+		 * @param output Reference to tick output.
+		 * 
+		 * @return \c Return_t::NOK if tick is not available.
+		 * @return \c Return_t::OK on success.
+		 */
+		static inline Return_t getTick(uint32_t& output)
+		{
+			return Bus::getTick(output);
+		}
+
+		private:
+		static constexpr uint8_t address = 0x5C; /**< @brief ILPS22QS' address on I2C bus. */
+		static constexpr uint8_t readTimeout = ILPS22QS_I2C_READ_TIMEOUT; /**< @brief Timeout in ms for read operation. */
+		static constexpr uint8_t writeTimeout = ILPS22QS_I2C_WRITE_TIMEOUT; /**< @brief Timeout in ms for write operation. */
 	};
 
 	/**
@@ -53,6 +53,14 @@ namespace Hardware
 	static constexpr uint8_t ptsSelectPin = 5; /**< @brief Pressure and temperature sensor select GPIO pin. */
 	static constexpr uint8_t ledPort = 0; /**< @brief LED GPIO port. */
 	static constexpr uint8_t ledPin = 2; /**< @brief LED GPIO pin. */
+	static constexpr uint8_t wakeLine = 0; /**< @brief Set to \c 1 if board has active low GPIO which wakes device from storage mode. Pressure sensor has no interrupt pin and rev1 has no wake GPIO. */
+	static constexpr uint8_t wakePort = 0; /**< @brief Storage mode wake GPIO port. Used only with \ref wakeLine */
+	static constexpr uint8_t wakePin = 0; /**< @brief Storage mode wake GPIO pin. Used only with \ref wakeLine */
+	#ifdef CONFIG_GPIO_AS_PINRESET
+	static constexpr uint8_t resetLine = 1; /**< @brief P0.21 is pin reset, pulling it low wakes device from storage mode. */
+	#else
+	static constexpr uint8_t resetLine = 0; /**< @brief Pin reset is not enabled, see \c CONFIG_GPIO_AS_PINRESET */
+	#endif // CONFIG_GPIO_AS_PINRESET
 };
 
 /**
@@ -63,6 +71,8 @@ namespace MemoryMap
 {
 	static constexpr uint32_t sramEEPROMStart = 0x2000FC00; /**< @brief Start address of SRAM EEPROM. */
 	static constexpr uint16_t sramEEPROMSize = 0x400; /**< @brief Size of SRAM EEPROM in bytes. */
+	static constexpr uint32_t authEpochStart = 0x7F000; /**< @brief Start address of flash page with authentication counter epoch log. */
+	static constexpr uint16_t authEpochSize = 0x1000; /**< @brief Size of authentication counter epoch log in bytes. One flash page. */
 };
 
 
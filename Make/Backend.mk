@@ -208,6 +208,10 @@ endif
 $(DIR_BUILD):
 	mkdir $@
 
+# PRINT SECTION SIZES
+size: $(DIR_BUILD)/$(BUILD_NAME).elf
+	$(TC_SZ) $<
+
 
 #######################################
 # FLASH CHIP
@@ -24,10 +24,14 @@
 
 // ----- INCLUDE FILES
 #include			"ADC.hpp"
+#include			"Scheduler.hpp"
+#include			"Power.hpp"
+#include			"AppConfig.hpp"
 
 #include			"nrf.h"
 #include			"nrf_saadc.h"
 #include			"nrf_nvic.h"
+#include			"nrf_soc.h"
 #include			"sdk_errors.h"
 #include			"app_error.h"
 
@@ -42,6 +46,11 @@
 // ----- VARIABLES
 static uint16_t adcRaw = 0; /**< @brief Output variable for ADC. */
 static uint16_t voltage = 0; /**< @brief Calculated voltage in mV. */
+static uint8_t armed = 0; /**< @brief Flag for sample armed on radio \c ADDRESS event. */
+
+
+// ----- STATIC CONSTANTS
+static constexpr uint8_t radioPPI = 3; /**< @brief PPI channel for \c RADIO \c ADDRESS -> \c SAADC \c SAMPLE. Channels 0-2 are used by TWI. */
 
 
 // ----- NAMESPACES
@@ -62,7 +71,8 @@ namespace ADC
 		// Enable END event
 		nrf_saadc_int_enable(NRF_SAADC_INT_END);
 		nrf_saadc_resolution_set(NRF_SAADC_RESOLUTION_12BIT);
-		nrf_saadc_oversample_set(NRF_SAADC_OVERSAMPLE_16X);
+		// Sample on radio must fit in one packet TX: 4x(10us + 2us) is about 50us, shortest legacy advertise packet is about 300us
+		nrf_saadc_oversample_set(AppConfig::adcOnRadio ? NRF_SAADC_OVERSAMPLE_4X : NRF_SAADC_OVERSAMPLE_16X);
 		nrf_saadc_buffer_init((nrf_saadc_value_t*)&adcRaw, 1);
 
 		// Configure ADC channel
@@ -72,7 +82,7 @@ namespace ADC
 			.resistor_n = NRF_SAADC_RESISTOR_DISABLED,
 			.gain = NRF_SAADC_GAIN1_6,
 			.reference = NRF_SAADC_REFERENCE_INTERNAL,
-			.acq_time = NRF_SAADC_ACQTIME_40US,
+			.acq_time = AppConfig::adcOnRadio ? NRF_SAADC_ACQTIME_10US : NRF_SAADC_ACQTIME_40US,
 			.mode = NRF_SAADC_MODE_SINGLE_ENDED,
 			.burst = NRF_SAADC_BURST_ENABLED,
 			.pin_p = NRF_SAADC_INPUT_VDD,
@@ -80,8 +90,20 @@ namespace ADC
 		};
 		nrf_saadc_channel_init(0, &chConfig);
 
+		// Radio ADDRESS event is sent after access address, so sample is taken while radio transmits
+		ret_code_t ret;
+		if (AppConfig::adcOnRadio)
+		{
+			ret = sd_ppi_channel_assign(radioPPI, &NRF_RADIO->EVENTS_ADDRESS, (const volatile void*)nrf_saadc_task_address_get(NRF_SAADC_TASK_SAMPLE));
+			if (ret != NRF_SUCCESS)
+			{
+				APP_ERROR_CHECK(ret);
+				return Return_t::NOK;
+			}
+		}
+
 		// Enable ADC IRQ
-		ret_code_t ret = sd_nvic_SetPriority(SAADC_IRQn, 3);
+		ret = sd_nvic_SetPriority(SAADC_IRQn, 3);
 		if (ret != NRF_SUCCESS)
 		{
 			APP_ERROR_CHECK(ret);
@@ -108,11 +130,55 @@ namespace ADC
 		voltage = 0;
 		adcRaw = 0;
 
-		nrf_saadc_enable();
+		Power::acquire(Power::Domain_t::SAADC);
 		nrf_saadc_task_trigger(NRF_SAADC_TASK_START);
 		nrf_saadc_task_trigger(NRF_SAADC_TASK_SAMPLE);
 	}
 
+	/**
+	 * @brief Arm battery sample on next radio \c ADDRESS event.
+	 * 
+	 * \c SAADC is started and waits for \c SAMPLE task from PPI. Buffer holds one sample, so only first packet is sampled.
+	 * Later \c ADDRESS events hit stopped \c SAADC and do nothing until \ref ADC::disarm disables PPI channel.
+	 * 
+	 * @return No return value.
+	 */
+	void arm(void)
+	{
+		voltage = 0;
+		adcRaw = 0;
+		armed = 1;
+
+		Power::acquire(Power::Domain_t::SAADC);
+		nrf_saadc_task_trigger(NRF_SAADC_TASK_START);
+		sd_ppi_channel_enable_set(1 << radioPPI);
+	}
+
+	/**
+	 * @brief Disable radio triggered sample.
+	 * 
+	 * Stops \c SAADC if radio event did not happen.
+	 * 
+	 * @return No return value.
+	 */
+	void disarm(void)
+	{
+		if (!armed)
+		{
+			return;
+		}
+
+		sd_ppi_channel_enable_clr(1 << radioPPI);
+		armed = 0;
+
+		// No sample was taken
+		if (!voltage)
+		{
+			nrf_saadc_task_trigger(NRF_SAADC_TASK_STOP);
+			Power::release(Power::Domain_t::SAADC);
+		}
+	}
+
 	/**
 	 * @brief Check if ADC is done with measuring.
 	 * 
@@ -158,10 +224,12 @@ extern "C"
 		{
 			nrf_saadc_event_clear(NRF_SAADC_EVENT_END);
 			nrf_saadc_task_trigger(NRF_SAADC_TASK_STOP);
-			nrf_saadc_disable();
+			Power::release(Power::Domain_t::SAADC);
 
 			voltage = (600 * ((adcRaw * 1000) / 4096) * 6) / 1000;
 			_PRINTF("ADC %u %u\n", adcRaw, voltage);
+
+			Scheduler::post(Scheduler::Event_t::ADCDone);
 		}
 	}
 }
@@ -0,0 +1,334 @@
+/**
+ * @file Auth.cpp
+ * @author silvio3105 (www.github.com/silvio3105)
+ * @brief Payload authentication module source file.
+ * 
+ * @copyright Copyright (c) 2025, silvio3105
+ * 
+ */
+
+/*
+	Copyright (c) 2025, silvio3105 (www.github.com/silvio3105)
+
+	Access and use of this Project and its contents are granted free of charge to any Person.
+	The Person is allowed to copy, modify and use The Project and its contents only for non-commercial use.
+	Commercial use of this Project and its contents is prohibited.
+	Modifying this License and/or sublicensing is prohibited.
+
+	THE PROJECT AND ITS CONTENT ARE PROVIDED "AS IS" WITH ALL FAULTS AND WITHOUT EXPRESSED OR IMPLIED WARRANTY.
+	THE AUTHOR KEEPS ALL RIGHTS TO CHANGE OR REMOVE THE CONTENTS OF THIS PROJECT WITHOUT PREVIOUS NOTICE.
+	THE AUTHOR IS NOT RESPONSIBLE FOR DAMAGE OF ANY KIND OR LIABILITY CAUSED BY USING THE CONTENTS OF THIS PROJECT.
+
+	This License shall be included in all functional textual files.
+*/
+// ----- INCLUDE FILES
+#include			"Auth.hpp"
+#include			"Data.hpp"
+
+#include			"nrf.h"
+#include			"nrf_soc.h"
+#include			"nrf_sdh_soc.h"
+#include			"ble_gap.h"
+#include			"app_error.h"
+
+#include			<string.h>
+
+
+/**
+ * @addtogroup Auth
+ * 
+ * Payload authentication module.
+ * Tag is AES-CMAC over 32-bit little endian epoch and counter followed by payload, truncated to \ref AppConfig::authTagSize bytes.
+ * Device key is AES of device MAC address with \ref AppConfig::authKey. AES blocks are computed by SoftDevice with hardware \c ECB.
+ * Every signed frame takes next counter value, so advertise and scan response of one advertise never share a counter.
+ * Counter lives in SRAM EEPROM and restarts after power loss, epoch is kept in flash log and increases every time counter restarts.
+ * @{
+ */
+
+// ----- VARIABLES
+static constexpr uint8_t maxLen = 32; /**< @brief Maximum payload length in bytes. */
+static nrf_ecb_hal_data_t ecb; /**< @brief ECB data with device key. */
+static uint8_t subkey1[SOC_ECB_KEY_LENGTH]; /**< @brief CMAC subkey for complete last block. */
+static uint8_t subkey2[SOC_ECB_KEY_LENGTH]; /**< @brief CMAC subkey for padded last block. */
+static uint8_t inited = 0; /**< @brief Set to \c 1 when device key and subkeys are ready. */
+static uint32_t epoch = 0; /**< @brief Counter epoch. */
+static volatile uint8_t flashBusy = 0; /**< @brief Set to \c 1 while SoftDevice flash operation is in progress. */
+static volatile uint8_t flashFail = 0; /**< @brief Set to \c 1 if last SoftDevice flash operation failed. */
+static constexpr uint16_t epochSlots = MemoryMap::authEpochSize / sizeof(uint32_t); /**< @brief Number of epoch entries in flash log. */
+static const volatile uint32_t* epochLog = (const volatile uint32_t*)MemoryMap::authEpochStart; /**< @brief Epoch flash log. Erased entries are \c 0xFFFFFFFF */
+
+
+// ----- STATIC FUNCTION DECLARATIONS
+static Return_t encrypt(void);
+static void shift(uint8_t* output, const uint8_t* input);
+static Return_t loadEpoch(void);
+static Return_t flashWait(const ret_code_t ret);
+static void onSoCEvent(uint32_t event, void* context);
+
+
+// ----- NAMESPACES
+/**
+ * @brief Payload authentication module namespace.
+ * 
+ */
+namespace Auth
+{
+	/**
+	 * @brief Init payload authentication.
+	 * 
+	 * Derives device key and CMAC subkeys and loads counter epoch.
+	 * 
+	 * @return \c Return_t::NOK on fail.
+	 * @return \c Return_t::OK on success.
+	 * 
+	 * @note SoftDevice must be enabled.
+	 */
+	Return_t init(void)
+	{
+		if (!AppConfig::authPayload)
+		{
+			return Return_t::OK;
+		}
+
+		// Register a handler for flash operation events
+		NRF_SDH_SOC_OBSERVER(m_soc_observer, 1, onSoCEvent, NULL);
+
+		if (loadEpoch() != Return_t::OK)
+		{
+			return Return_t::NOK;
+		}
+
+		ble_gap_addr_t addr;
+		ret_code_t ret = sd_ble_gap_addr_get(&addr);
+		if (ret != NRF_SUCCESS)
+		{
+			APP_ERROR_CHECK(ret);
+			return Return_t::NOK;
+		}
+
+		// Device key
+		memcpy(ecb.key, AppConfig::authKey, SOC_ECB_KEY_LENGTH);
+		memset(ecb.cleartext, 0, SOC_ECB_CLEARTEXT_LENGTH);
+		memcpy(ecb.cleartext, addr.addr, BLE_GAP_ADDR_LEN);
+		if (encrypt() != Return_t::OK)
+		{
+			return Return_t::NOK;
+		}
+		memcpy(ecb.key, ecb.ciphertext, SOC_ECB_KEY_LENGTH);
+
+		// CMAC subkeys from encrypted zero block
+		memset(ecb.cleartext, 0, SOC_ECB_CLEARTEXT_LENGTH);
+		if (encrypt() != Return_t::OK)
+		{
+			return Return_t::NOK;
+		}
+		shift(subkey1, ecb.ciphertext);
+		shift(subkey2, subkey1);
+
+		inited = 1;
+		return Return_t::OK;
+	}
+
+	/**
+	 * @brief Increase authentication counter and append authentication trailer to payload.
+	 * 
+	 * @param payload Pointer to payload with at least \ref size free bytes after \c len
+	 * @param len Length of payload.
+	 * 
+	 * @return \c Return_t::NOK if module is not inited, trailer is zeroed.
+	 * @return \c Return_t::OK on success.
+	 * 
+	 * @note Counter is kept in SRAM EEPROM and restarts from \c 0 only after power loss. Epoch is increased on next \ref init then.
+	 */
+	Return_t sign(uint8_t* payload, const uint8_t len)
+	{
+		if (!AppConfig::authPayload)
+		{
+			return Return_t::OK;
+		}
+
+		if (!inited || len > maxLen)
+		{
+			memset(&payload[len], 0, size);
+			return Return_t::NOK;
+		}
+
+		// Message is epoch and counter followed by payload
+		const uint32_t counter = ++Data::eeprom->authCounter;
+		uint8_t msg[sizeof(epoch) + sizeof(counter) + maxLen];
+		memcpy(msg, &epoch, sizeof(epoch));
+		memcpy(&msg[sizeof(epoch)], &counter, sizeof(counter));
+		memcpy(&msg[sizeof(epoch) + sizeof(counter)], payload, len);
+		const uint8_t msgLen = sizeof(epoch) + sizeof(counter) + len;
+
+		// CBC over all blocks, last block is XOR-ed with subkey
+		memset(ecb.ciphertext, 0, SOC_ECB_CIPHERTEXT_LENGTH);
+		for (uint8_t block = 0; block < msgLen; block += SOC_ECB_CLEARTEXT_LENGTH)
+		{
+			const uint8_t blockLen = (msgLen - block < SOC_ECB_CLEARTEXT_LENGTH) ? (msgLen - block) : SOC_ECB_CLEARTEXT_LENGTH;
+			const uint8_t last = (block + SOC_ECB_CLEARTEXT_LENGTH >= msgLen);
+
+			for (uint8_t i = 0; i < SOC_ECB_CLEARTEXT_LENGTH; i++)
+			{
+				uint8_t byte = (i < blockLen) ? msg[block + i] : ((i == blockLen) ? 0x80 : 0);
+				if (last)
+				{
+					byte ^= (blockLen == SOC_ECB_CLEARTEXT_LENGTH) ? subkey1[i] : subkey2[i];
+				}
+
+				ecb.cleartext[i] = ecb.ciphertext[i] ^ byte;
+			}
+
+			if (encrypt() != Return_t::OK)
+			{
+				memset(&payload[len], 0, size);
+				return Return_t::NOK;
+			}
+		}
+
+		payload[len] = counter & 0xFF;
+		memcpy(&payload[len + 1], ecb.ciphertext, AppConfig::authTagSize);
+
+		return Return_t::OK;
+	}
+};
+
+
+// ----- STATIC FUNCTION DEFINITIONS
+/**
+ * @brief Encrypt \c ecb cleartext with hardware \c ECB.
+ * 
+ * @return \c Return_t::NOK on fail.
+ * @return \c Return_t::OK on success.
+ */
+static Return_t encrypt(void)
+{
+	ret_code_t ret = sd_ecb_block_encrypt(&ecb);
+	if (ret != NRF_SUCCESS)
+	{
+		APP_ERROR_CHECK(ret);
+		return Return_t::NOK;
+	}
+
+	return Return_t::OK;
+}
+
+/**
+ * @brief Shift block left by one bit and XOR with CMAC constant if MSB was set.
+ * 
+ * @param output Pointer to output block.
+ * @param input Pointer to input block.
+ * 
+ * @return No return value.
+ */
+static void shift(uint8_t* output, const uint8_t* input)
+{
+	const uint8_t msb = input[0] & 0x80;
+	for (uint8_t i = 0; i < SOC_ECB_KEY_LENGTH - 1; i++)
+	{
+		output[i] = (input[i] << 1) | (input[i + 1] >> 7);
+	}
+	output[SOC_ECB_KEY_LENGTH - 1] = input[SOC_ECB_KEY_LENGTH - 1] << 1;
+
+	if (msb)
+	{
+		output[SOC_ECB_KEY_LENGTH - 1] ^= 0x87;
+	}
+}
+
+/**
+ * @brief Load counter epoch from flash log.
+ * 
+ * Epoch is last written entry of the log. If counter restarted after power loss, next epoch is appended to the log.
+ * Full log page is erased before new entry is written.
+ * 
+ * @return \c Return_t::NOK on fail.
+ * @return \c Return_t::OK on success.
+ */
+static Return_t loadEpoch(void)
+{
+	uint16_t slot = 0;
+	while (slot < epochSlots && epochLog[slot] != 0xFFFFFFFF)
+	{
+		slot++;
+	}
+	epoch = slot ? epochLog[slot - 1] : 0;
+
+	// Counter survived reset, frames signed in this epoch continue
+	if (Data::eeprom->authCounter)
+	{
+		return Return_t::OK;
+	}
+
+	// Counter restarted so move to new epoch, otherwise old frames would be valid again
+	epoch++;
+	if (slot >= epochSlots)
+	{
+		flashBusy = 1;
+		if (flashWait(sd_flash_page_erase(MemoryMap::authEpochStart / NRF_FICR->CODEPAGESIZE)) != Return_t::OK)
+		{
+			_PRINT_ERROR("Epoch erase fail\n");
+			return Return_t::NOK;
+		}
+		slot = 0;
+	}
+
+	flashBusy = 1;
+	if (flashWait(sd_flash_write((uint32_t*)&epochLog[slot], &epoch, 1)) != Return_t::OK)
+	{
+		_PRINT_ERROR("Epoch write fail\n");
+		return Return_t::NOK;
+	}
+
+	_PRINTF_INFO("Auth epoch %lu\n", epoch);
+	return Return_t::OK;
+}
+
+/**
+ * @brief Wait for SoftDevice flash operation to finish.
+ * 
+ * @param ret Return code of SoftDevice flash call.
+ * 
+ * @return \c Return_t::NOK on fail.
+ * @return \c Return_t::OK on success.
+ */
+static Return_t flashWait(const ret_code_t ret)
+{
+	if (ret != NRF_SUCCESS)
+	{
+		flashBusy = 0;
+		APP_ERROR_CHECK(ret);
+		return Return_t::NOK;
+	}
+
+	while (flashBusy)
+	{
+		sd_app_evt_wait();
+	}
+
+	return flashFail ? Return_t::NOK : Return_t::OK;
+}
+
+/**
+ * @brief SoftDevice SoC event handler.
+ * 
+ * @param event SoC event ID.
+ * @param context Not used.
+ * 
+ * @return No return value.
+ */
+static void onSoCEvent(uint32_t event, void* context)
+{
+	(void)context;
+
+	if (event == NRF_EVT_FLASH_OPERATION_SUCCESS || event == NRF_EVT_FLASH_OPERATION_ERROR)
+	{
+		flashFail = (event == NRF_EVT_FLASH_OPERATION_ERROR);
+		flashBusy = 0;
+	}
+}
+
+
+/** @} */
+
+// END WITH NEW LINE
@@ -25,6 +25,7 @@
 // ----- INCLUDE FILES
 #include 			"BLE.hpp"
 #include			"Main.hpp"
+#include			"Scheduler.hpp"
 
 #include 			"nrf.h"
 #include 			"app_error.h"
@@ -47,31 +48,64 @@
 
 
 
+// ----- STRUCTS
+/**
+ * @brief Double buffered advertise or scan response data struct.
+ * 
+ */
+struct AdvData_s
+{
+	static constexpr uint8_t size = (AppConfig::advMode != AppConfig::AdvMode_t::Legacy) ? (2 * BLE_GAP_ADV_SET_DATA_SIZE_MAX) : BLE_GAP_ADV_SET_DATA_SIZE_MAX; /**< @brief Size of raw data buffer. Extended advertise data does not have to fit into 31 bytes. */
+
+	uint8_t raw[2][size]; /**< @brief Raw data buffers. SoftDevice owns buffer \ref advBuffer */
+	ble_data_t* gapData; /**< @brief Pointer to data descriptor handed to SoftDevice. */
+	uint8_t scanResponse; /**< @brief \c 1 for scan response data, \c 0 for advertise data. */
+	uint8_t mnfDataOffset; /**< @brief Offset of manufacturer data payload in \ref raw buffers. \c 0 if data is not encoded. */
+	uint8_t mnfDataLen; /**< @brief Length of manufacturer data payload. */
+	uint8_t encoded; /**< @brief Set to \c 1 if data was encoded again and released buffer must be synced. */
+};
+
+
 // ----- VARIABLES
+static constexpr uint8_t advExtended = (AppConfig::advMode != AppConfig::AdvMode_t::Legacy); /**< @brief Set to \c 1 if extended advertise is used. Extended advertise has no scan response. */
 static int8_t txPower = AppConfig::advTXPower; /**< @brief TX power in dBm. */
 static uint8_t advHandle = BLE_GAP_ADV_SET_HANDLE_NOT_SET; /**< @brief Advertisement handle. */
-static uint8_t gapAdvDataRaw[BLE_GAP_ADV_SET_DATA_SIZE_MAX]; /**< @brief Raw advertise data. */
+static uint8_t advBuffer = 0; /**< @brief Index of \ref AdvData_s::raw buffer in use by SoftDevice. */
 static ble_gap_adv_params_t advConfig; /**< @brief Advertise configuration. */
-static ble_gap_adv_data_t gapAdvData = /**< @brief Advertise and scan response data. */
+static ble_gap_adv_data_t gapAdvData; /**< @brief Advertise and scan response data descriptors. */
+static AdvData_s advData = /**< @brief Advertise data with flags and measurement payload. */
 {
-	.adv_data =
-	{
-		.p_data = gapAdvDataRaw,
-		.len = sizeof(gapAdvDataRaw)
-	},
-		
-	.scan_rsp_data =	
-	{
-		.p_data = nullptr,
-		.len = 0
-	}
+	.raw = {},
+	.gapData = &gapAdvData.adv_data,
+	.scanResponse = 0,
+	.mnfDataOffset = 0,
+	.mnfDataLen = 0,
+	.encoded = 0
+};
+static AdvData_s scanData = /**< @brief Scan response data with device name and diagnostic payload. */
+{
+	.raw = {},
+	.gapData = &gapAdvData.scan_rsp_data,
+	.scanResponse = 1,
+	.mnfDataOffset = 0,
+	.mnfDataLen = 0,
+	.encoded = 0
 };
 static uint8_t advDone = 0; /**< @brief Advertise done flag. */
+static uint8_t advChannel = 0; /**< @brief Index of first primary channel for next advertise event. \c 0 is channel 37. */
+static uint8_t advChannelMap = 0; /**< @brief Bitmap of primary channels used by last advertise event. Bit 0 is channel 37. */
+static BLE::Adv_t advProfile = BLE::Adv_t::Normal; /**< @brief Advertise type for which event count, interval and advertise type are set. \c Normal and \c AllChannels share profile. */
+static uint16_t connHandle = BLE_CONN_HANDLE_INVALID; /**< @brief Connection handle. */
+NRF_BLE_GATT_DEF(gatt); /**< @brief GATT module instance for ATT MTU and data length negotiation. */
 
 
 // ----- STATIC FUNCTION DECLARATIONS
 static Return_t gapInit(void);
-static Return_t advInit(void);
+static Return_t advInit(const void* data, const uint8_t len, const void* scan, const uint8_t scanLen);
+static Return_t encode(AdvData_s& adv, const uint8_t idx, const void* data, const uint8_t len);
+static Return_t stage(AdvData_s& adv, const uint8_t idx, const void* data, const uint8_t len);
+static void sync(AdvData_s& adv);
+static uint8_t setParams(const BLE::Adv_t type);
 static void onBLEEvent(ble_evt_t const* event, void* context);
 
 
@@ -86,10 +120,15 @@ namespace BLE
 	/**
 	 * @brief Init Bluetooth module.
 	 * 
+	 * @param data Pointer to initial manufacturer data for advertise.
+	 * @param len Length of \c data
+	 * @param scan Pointer to initial manufacturer data for scan response.
+	 * @param scanLen Length of \c scan
+	 * 
 	 * @return \c Return_t::NOK on fail.
 	 * @return \c Return_t::OK on success.
 	 */
-	Return_t init(void)
+	Return_t init(const void* data, const uint8_t len, const void* scan, const uint8_t scanLen)
 	{
 		ret_code_t ret = nrf_sdh_enable_request();
 		if (ret != NRF_SUCCESS)
@@ -107,8 +146,10 @@ namespace BLE
 			return Return_t::NOK;
 		}
 	
-		// Enable BLE stack.
+		// Enable BLE stack. RAM start is updated to the one SoftDevice needs, linker RAM origin must not be below it
+		const uint32_t ramLinked = ramStart;
 		ret = nrf_sdh_ble_enable(&ramStart);
+		_PRINTF_INFO("SoftDevice RAM start: %08lX, linked %08lX\n", ramStart, ramLinked);
 		if (ret != NRF_SUCCESS)
 		{
 			APP_ERROR_CHECK(ret);
@@ -118,6 +159,31 @@ namespace BLE
 		// Register a handler for BLE events.
 		NRF_SDH_BLE_OBSERVER(m_ble_observer, 3, onBLEEvent, NULL);
 
+		// Negotiate large ATT MTU and 251 byte LL PDU on connection
+		if (AppConfig::connPeriod)
+		{
+			ret = nrf_ble_gatt_init(&gatt, nullptr);
+			if (ret != NRF_SUCCESS)
+			{
+				APP_ERROR_CHECK(ret);
+				return Return_t::NOK;
+			}
+
+			ret = nrf_ble_gatt_att_mtu_periph_set(&gatt, NRF_SDH_BLE_GATT_MAX_MTU_SIZE);
+			if (ret != NRF_SUCCESS)
+			{
+				APP_ERROR_CHECK(ret);
+				return Return_t::NOK;
+			}
+
+			ret = nrf_ble_gatt_data_length_set(&gatt, BLE_CONN_HANDLE_INVALID, NRF_SDH_BLE_GAP_DATA_LENGTH);
+			if (ret != NRF_SUCCESS)
+			{
+				APP_ERROR_CHECK(ret);
+				return Return_t::NOK;
+			}
+		}
+
 		// Init GAP profile
 		if (gapInit() != Return_t::OK)
 		{
@@ -143,7 +209,7 @@ namespace BLE
 		}
 
 		// Init advertise
-		return advInit();
+		return advInit(data, len, scan, scanLen);
 	}
 
 	/**
@@ -166,34 +232,48 @@ namespace BLE
 	/**
 	 * @brief Advertise data.
 	 * 
+	 * New data is patched into advertise and scan response buffers which are not in use by SoftDevice and buffers are swapped.
+	 * Data is encoded again only if its length changed.
+	 * Scan response goes on air only when scanner requests it, in extended advertise mode \c scan is ignored.
+	 * 
+	 * @param data Pointer to manufacturer data for advertise.
+	 * @param len Length of \c data
+	 * @param scan Pointer to manufacturer data for scan response.
+	 * @param scanLen Length of \c scan
+	 * @param type Advertise type. See \ref Adv_t
+	 * 
 	 * @return \c Return_t::NOK on fail.
 	 * @return \c Return_t::OK on success.
 	 */
-	Return_t advertise(const void* data, const uint8_t len)
+	Return_t advertise(const void* data, const uint8_t len, const void* scan, const uint8_t scanLen, const Adv_t type)
 	{
-		// Set custom data
-		ble_advdata_manuf_data_t mnfData;
-		
-		mnfData.company_identifier = AppConfig::bleMnfID;
-		mnfData.data.p_data = (uint8_t*)data;
-		mnfData.data.size = len;
-	
-		// Set advertise data
-		ble_advdata_t advData;
-		memset(&advData, 0, sizeof(advData));
-		advData.name_type = BLE_ADVDATA_FULL_NAME;
-		advData.flags = BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
-		advData.p_manuf_specific_data = &mnfData;
-		advData.p_tx_power_level = &txPower;
-	
-		// Encode advertise data
-		ret_code_t ret = ble_advdata_encode(&advData, gapAdvData.adv_data.p_data, &gapAdvData.adv_data.len);
+		// Patch manufacturer data into free buffers
+		const uint8_t next = advBuffer ^ 1;
+		if (stage(advData, next, data, len) != Return_t::OK || (!advExtended && stage(scanData, next, scan, scanLen) != Return_t::OK))
+		{
+			return Return_t::NOK;
+		}
+
+		// Hand patched buffers to SoftDevice
+		gapAdvData.adv_data.p_data = advData.raw[next];
+		gapAdvData.scan_rsp_data.p_data = advExtended ? nullptr : scanData.raw[next];
+		// Advertise parameters are passed only if channel mask or burst changed
+		const ble_gap_adv_params_t* params = setParams(type) ? &advConfig : nullptr;
+		ret_code_t ret = sd_ble_gap_adv_set_configure(&advHandle, &gapAdvData, params);
 		if (ret != NRF_SUCCESS)
-		{	
+		{
+			// Force advertise parameters on next configure
+			advChannelMap = 0;
+			gapAdvData.adv_data.p_data = advData.raw[advBuffer];
+			gapAdvData.scan_rsp_data.p_data = advExtended ? nullptr : scanData.raw[advBuffer];
 			APP_ERROR_CHECK(ret);
 			return Return_t::NOK;
 		}
 
+		advBuffer = next;
+		sync(advData);
+		sync(scanData);
+
 		// Advertise data
 		advDone = 0;
 		ret = sd_ble_gap_adv_start(advHandle, AppConfig::bleTag);
@@ -222,6 +302,69 @@ namespace BLE
 
 		return Return_t::NOK;
 	}
+
+	/**
+	 * @brief Get primary channels used by last advertise event.
+	 * 
+	 * @return Bitmap of primary channels. Bit 0 is channel 37, bit 1 is channel 38 and bit 2 is channel 39.
+	 */
+	uint8_t getChannels(void)
+	{
+		return advChannelMap;
+	}
+
+	/**
+	 * @brief Check if central is connected.
+	 * 
+	 * @return \c 1 if connected, \c 0 otherwise.
+	 */
+	uint8_t isConnected(void)
+	{
+		return (connHandle != BLE_CONN_HANDLE_INVALID);
+	}
+
+	/**
+	 * @brief Terminate connection.
+	 * 
+	 * @return \c Return_t::NOK on fail.
+	 * @return \c Return_t::OK on success or if there is no connection.
+	 */
+	Return_t disconnect(void)
+	{
+		if (connHandle == BLE_CONN_HANDLE_INVALID)
+		{
+			return Return_t::OK;
+		}
+
+		ret_code_t ret = sd_ble_gap_disconnect(connHandle, BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
+		if (ret != NRF_SUCCESS && ret != NRF_ERROR_INVALID_STATE)
+		{
+			APP_ERROR_CHECK(ret);
+			return Return_t::NOK;
+		}
+
+		return Return_t::OK;
+	}
+
+	/**
+	 * @brief Get connection handle.
+	 * 
+	 * @return Connection handle, \c BLE_CONN_HANDLE_INVALID if not connected.
+	 */
+	uint16_t getConnection(void)
+	{
+		return connHandle;
+	}
+
+	/**
+	 * @brief Get effective ATT MTU of connection.
+	 * 
+	 * @return ATT MTU in bytes.
+	 */
+	uint16_t getMTU(void)
+	{
+		return nrf_ble_gatt_eff_mtu_get(&gatt, connHandle);
+	}
 };
 
 
@@ -244,25 +387,68 @@ static Return_t gapInit(void)
 		return Return_t::NOK;
 	}
 
+	// Short connection interval so history download is done quickly
+	static const ble_gap_conn_params_t connParams =
+	{
+		.min_conn_interval = (uint16_t)MSEC_TO_UNITS(7.5, UNIT_1_25_MS), // 6 units, macro gives double for fractional ms
+		.max_conn_interval = MSEC_TO_UNITS(15, UNIT_1_25_MS),
+		.slave_latency = 0,
+		.conn_sup_timeout = MSEC_TO_UNITS(4000, UNIT_10_MS)
+	};
+	ret = sd_ble_gap_ppcp_set(&connParams);
+	if (ret != NRF_SUCCESS)
+	{
+		APP_ERROR_CHECK(ret);
+		return Return_t::NOK;
+	}
+
 	return Return_t::OK;
 }
 
 /**
  * @brief Init BLE advertise.
  * 
+ * Static part of advertise and scan response data is encoded only here, \ref BLE::advertise patches manufacturer data only.
+ * 
+ * @param data Pointer to initial manufacturer data for advertise.
+ * @param len Length of \c data
+ * @param scan Pointer to initial manufacturer data for scan response.
+ * @param scanLen Length of \c scan
+ * 
  * @return \c Return_t::NOK on fail.
  * @return \c Return_t::OK on success. 
  */
-static Return_t advInit(void)
+static Return_t advInit(const void* data, const uint8_t len, const void* scan, const uint8_t scanLen)
 {
+	static_assert(AppConfig::advMode != AppConfig::AdvMode_t::ExtendedCoded, "LE Coded PHY is not supported by s132 and nRF52832");
+
+	// Encode advertise and scan response data once into both buffers
+	advBuffer = 0;
+	if (encode(advData, advBuffer, data, len) != Return_t::OK || (!advExtended && encode(scanData, advBuffer, scan, scanLen) != Return_t::OK))
+	{
+		return Return_t::NOK;
+	}
+	sync(advData);
+	sync(scanData);
+	gapAdvData.adv_data.p_data = advData.raw[advBuffer];
+	gapAdvData.scan_rsp_data.p_data = advExtended ? nullptr : scanData.raw[advBuffer];
+
 	// Set advertise config
-	advConfig.primary_phy = BLE_GAP_PHY_AUTO;
+	if (advExtended)
+	{
+		// Primary channels carry only short ADV_EXT_IND, payload goes in AUX_ADV_IND on secondary PHY
+		advConfig.primary_phy = BLE_GAP_PHY_1MBPS;
+		advConfig.secondary_phy = BLE_GAP_PHY_2MBPS;
+		advConfig.set_id = 0;
+	}
+	else
+	{
+		advConfig.primary_phy = BLE_GAP_PHY_AUTO;
+	}
 	advConfig.duration = 0;
-	advConfig.properties.type = BLE_GAP_ADV_TYPE_NONCONNECTABLE_SCANNABLE_UNDIRECTED;
-	advConfig.max_adv_evts	= AppConfig::advCount;
 	advConfig.p_peer_addr = nullptr;
 	advConfig.filter_policy = BLE_GAP_ADV_FP_ANY;
-	advConfig.interval = 32; // Does not matter since max advertise event is set to 1 
+	setParams(BLE::Adv_t::AllChannels);
 
 	ret_code_t ret = sd_ble_gap_adv_set_configure(&advHandle, &gapAdvData, &advConfig);
 	if (ret != NRF_SUCCESS)
@@ -282,6 +468,184 @@ static Return_t advInit(void)
 	return Return_t::OK;
 }
 
+/**
+ * @brief Encode advertise or scan response data and locate manufacturer data payload.
+ * 
+ * Advertise data carries flags and manufacturer data, scan response carries device name and manufacturer data.
+ * In extended advertise mode there is no scan response and device name is not sent, scanners find sensor by manufacturer company ID.
+ * 
+ * @param adv Reference to data to encode. See \ref AdvData_s
+ * @param idx Index of output buffer.
+ * @param data Pointer to manufacturer data.
+ * @param len Length of \c data
+ * 
+ * @return \c Return_t::NOK on fail.
+ * @return \c Return_t::OK on success. 
+ */
+static Return_t encode(AdvData_s& adv, const uint8_t idx, const void* data, const uint8_t len)
+{
+	uint8_t* buffer = adv.raw[idx];
+
+	// Set custom data
+	ble_advdata_manuf_data_t mnfData;
+	
+	mnfData.company_identifier = AppConfig::bleMnfID;
+	mnfData.data.p_data = (uint8_t*)data;
+	mnfData.data.size = len;
+
+	// Set advertise data
+	ble_advdata_t bleData;
+	memset(&bleData, 0, sizeof(bleData));
+	bleData.name_type = adv.scanResponse ? BLE_ADVDATA_FULL_NAME : BLE_ADVDATA_NO_NAME;
+	bleData.flags = adv.scanResponse ? 0 : BLE_GAP_ADV_FLAGS_LE_ONLY_GENERAL_DISC_MODE;
+	bleData.p_manuf_specific_data = &mnfData;
+
+	// Encode advertise data
+	adv.mnfDataOffset = 0;
+	adv.encoded = 1;
+	uint16_t encodedLen = AdvData_s::size;
+	ret_code_t ret = ble_advdata_encode(&bleData, buffer, &encodedLen);
+	if (ret != NRF_SUCCESS)
+	{	
+		APP_ERROR_CHECK(ret);
+		return Return_t::NOK;
+	}
+	adv.gapData->len = encodedLen;
+
+	// Find manufacturer data AD structure(length, type, company ID, payload)
+	for (uint8_t i = 0; i + 1 < encodedLen; i += buffer[i] + 1)
+	{
+		if (!buffer[i])
+		{
+			break;
+		}
+
+		if (buffer[i + 1] == BLE_GAP_AD_TYPE_MANUFACTURER_SPECIFIC_DATA)
+		{
+			adv.mnfDataOffset = i + 2 + sizeof(mnfData.company_identifier);
+			adv.mnfDataLen = len;
+			break;
+		}
+	}
+
+	return Return_t::OK;
+}
+
+/**
+ * @brief Put new manufacturer data into buffer.
+ * 
+ * Data is patched in place if its length did not change, otherwise whole buffer is encoded again.
+ * 
+ * @param adv Reference to data. See \ref AdvData_s
+ * @param idx Index of buffer which is not in use by SoftDevice.
+ * @param data Pointer to manufacturer data.
+ * @param len Length of \c data
+ * 
+ * @return \c Return_t::NOK on fail.
+ * @return \c Return_t::OK on success. 
+ */
+static Return_t stage(AdvData_s& adv, const uint8_t idx, const void* data, const uint8_t len)
+{
+	if (adv.mnfDataOffset && adv.mnfDataLen == len)
+	{
+		memcpy(&adv.raw[idx][adv.mnfDataOffset], data, len);
+		return Return_t::OK;
+	}
+
+	return encode(adv, idx, data, len);
+}
+
+/**
+ * @brief Copy buffer in use by SoftDevice into free buffer after data was encoded again.
+ * 
+ * Both buffers must have the same layout so next \ref stage can patch manufacturer data only.
+ * 
+ * @param adv Reference to data. See \ref AdvData_s
+ * 
+ * @return No return value.
+ */
+static void sync(AdvData_s& adv)
+{
+	if (adv.encoded)
+	{
+		memcpy(adv.raw[advBuffer ^ 1], adv.raw[advBuffer], adv.gapData->len);
+		adv.encoded = 0;
+	}
+}
+
+/**
+ * @brief Set primary channel mask, advertise type and event count in advertise config for next advertise event.
+ * 
+ * With less than 3 channels in \ref AppConfig::advChannels first channel rotates every normal advertise so all channels are used equally.
+ * Alarm advertise uses all channels and sends burst of \ref AppConfig::alarmAdvCount events.
+ * Connectable advertise uses all channels and keeps device connectable for \ref AppConfig::connAdvCount events.
+ * 
+ * @param type Advertise type. See \ref BLE::Adv_t
+ * 
+ * @return \c 1 if advertise config changed, \c 0 otherwise.
+ */
+static uint8_t setParams(const BLE::Adv_t type)
+{
+	static_assert(AppConfig::advChannels >= 1 && AppConfig::advChannels <= 3, "Number of advertise channels must be 1, 2 or 3");
+
+	uint8_t map = 0b111;
+	if (type == BLE::Adv_t::Normal && AppConfig::advChannels < 3)
+	{
+		map = 0;
+		for (uint8_t i = 0; i < AppConfig::advChannels; i++)
+		{
+			map |= 1 << ((advChannel + i) % 3);
+		}
+		advChannel = (advChannel + 1) % 3;
+	}
+
+	const BLE::Adv_t profile = (type == BLE::Adv_t::AllChannels) ? BLE::Adv_t::Normal : type;
+	if (map == advChannelMap && profile == advProfile)
+	{
+		return 0;
+	}
+
+	// Channels 37 - 39 are bits 5 - 7 of last mask byte, set bit masks channel out
+	advChannelMap = map;
+	advConfig.channel_mask[4] = (~map & 0b111) << 5;
+
+	advProfile = profile;
+	switch (profile)
+	{
+		case BLE::Adv_t::Alarm:
+		{
+			advConfig.max_adv_evts = AppConfig::alarmAdvCount;
+			advConfig.interval = AppConfig::alarmAdvInterval;
+			break;
+		}
+
+		case BLE::Adv_t::Connectable:
+		{
+			advConfig.max_adv_evts = AppConfig::connAdvCount;
+			advConfig.interval = AppConfig::connAdvInterval;
+			break;
+		}
+
+		default:
+		{
+			advConfig.max_adv_evts = AppConfig::advCount;
+			advConfig.interval = 32; // Does not matter for single advertise event
+			break;
+		}
+	}
+
+	if (profile == BLE::Adv_t::Connectable)
+	{
+		advConfig.properties.type = advExtended ? BLE_GAP_ADV_TYPE_EXTENDED_CONNECTABLE_NONSCANNABLE_UNDIRECTED : BLE_GAP_ADV_TYPE_CONNECTABLE_SCANNABLE_UNDIRECTED;
+	}
+	else
+	{
+		advConfig.properties.type = advExtended ? BLE_GAP_ADV_TYPE_EXTENDED_NONCONNECTABLE_NONSCANNABLE_UNDIRECTED : BLE_GAP_ADV_TYPE_NONCONNECTABLE_SCANNABLE_UNDIRECTED;
+	}
+
+	return 1;
+}
+
 /**
  * @brief BLE stack event handler.
  * 
@@ -300,14 +664,42 @@ static void onBLEEvent(ble_evt_t const* event, void* context)
 		case BLE_GAP_EVT_DISCONNECTED:
 		{
 			_PRINT_INFO("BLE disconnected\n");
+			connHandle = BLE_CONN_HANDLE_INVALID;
 			break;
 		}
 
 		case BLE_GAP_EVT_CONNECTED:
 		{
 			_PRINT_INFO("BLE connect\n");
-			ret = sd_ble_gap_disconnect(event->evt.gattc_evt.conn_handle,
-				BLE_HCI_REMOTE_USER_TERMINATED_CONNECTION);
+			connHandle = event->evt.gap_evt.conn_handle;
+
+			// Connection stops advertise without advertise set terminated event
+			advDone = 1;
+			Scheduler::post(Scheduler::Event_t::AdvertiseDone);
+
+			// Move to 2M PHY for history download
+			static const ble_gap_phys_t phys =
+			{
+				.tx_phys = BLE_GAP_PHY_2MBPS,
+				.rx_phys = BLE_GAP_PHY_2MBPS,
+			};
+			ret = sd_ble_gap_phy_update(connHandle, &phys);
+			APP_ERROR_CHECK(ret);
+			break;
+		}
+
+		case BLE_GAP_EVT_SEC_PARAMS_REQUEST:
+		{
+			// Pairing is not supported
+			ret = sd_ble_gap_sec_params_reply(event->evt.gap_evt.conn_handle, BLE_GAP_SEC_STATUS_PAIRING_NOT_SUPP, nullptr, nullptr);
+			APP_ERROR_CHECK(ret);
+			break;
+		}
+
+		case BLE_GATTS_EVT_SYS_ATTR_MISSING:
+		{
+			// No bonding, so there are no stored system attributes
+			ret = sd_ble_gatts_sys_attr_set(event->evt.gatts_evt.conn_handle, nullptr, 0, 0);
 			APP_ERROR_CHECK(ret);
 			break;
 		}
@@ -346,6 +738,7 @@ static void onBLEEvent(ble_evt_t const* event, void* context)
 		case BLE_GAP_EVT_ADV_SET_TERMINATED:
 		{
 			advDone = 1;	
+			Scheduler::post(Scheduler::Event_t::AdvertiseDone);
 			_PRINT_INFO("Advertise done\n");
 			break;
 		}
@@ -0,0 +1,290 @@
+/**
+ * @file History.cpp
+ * @author silvio3105 (www.github.com/silvio3105)
+ * @brief History GATT service source file.
+ * 
+ * @copyright Copyright (c) 2025, silvio3105
+ * 
+ */
+
+/*
+	Copyright (c) 2025, silvio3105 (www.github.com/silvio3105)
+
+	Access and use of this Project and its contents are granted free of charge to any Person.
+	The Person is allowed to copy, modify and use The Project and its contents only for non-commercial use.
+	Commercial use of this Project and its contents is prohibited.
+	Modifying this License and/or sublicensing is prohibited.
+
+	THE PROJECT AND ITS CONTENT ARE PROVIDED "AS IS" WITH ALL FAULTS AND WITHOUT EXPRESSED OR IMPLIED WARRANTY.
+	THE AUTHOR KEEPS ALL RIGHTS TO CHANGE OR REMOVE THE CONTENTS OF THIS PROJECT WITHOUT PREVIOUS NOTICE.
+	THE AUTHOR IS NOT RESPONSIBLE FOR DAMAGE OF ANY KIND OR LIABILITY CAUSED BY USING THE CONTENTS OF THIS PROJECT.
+
+	This License shall be included in all functional textual files.
+*/
+// ----- INCLUDE FILES
+#include			"History.hpp"
+#include			"BLE.hpp"
+#include			"Data.hpp"
+
+#include			"nrf.h"
+#include			"app_error.h"
+#include			"nrf_sdh_ble.h"
+#include			"ble.h"
+#include			"ble_gatts.h"
+
+#include			<string.h>
+
+
+/**
+ * @addtogroup History
+ * 
+ * History GATT service. Streams pressure history from SRAM EEPROM in notifications as large as ATT MTU allows.
+ * First notification starts with number of samples, followed by samples in mbar as 16-bit little endian values, oldest first.
+ * Streaming starts when client enables notifications. Device terminates connection once all notifications are sent.
+ * @{
+ */
+
+// ----- VARIABLES
+static constexpr ble_uuid128_t uuidBase = /**< @brief Vendor specific UUID base. Service and characteristic UUIDs are bytes 12 and 13. */
+{
+	{ 0x9B, 0x3C, 0x51, 0x7E, 0x0A, 0x42, 0x4F, 0x8D, 0xA1, 0x6B, 0x2E, 0x74, 0x00, 0x00, 0x05, 0x31 }
+};
+static constexpr uint16_t uuidService = 0x0001; /**< @brief History service UUID. */
+static constexpr uint16_t uuidHistory = 0x0002; /**< @brief History characteristic UUID. */
+
+static uint16_t serviceHandle = 0; /**< @brief History service handle. */
+static ble_gatts_char_handles_t historyHandles; /**< @brief History characteristic handles. */
+static uint16_t samples[AppConfig::historySize]; /**< @brief History snapshot taken when streaming starts. */
+static uint8_t sampleCount = 0; /**< @brief Number of samples in \ref samples */
+static uint8_t sampleIdx = 0; /**< @brief Index of next sample to send. */
+static uint8_t streaming = 0; /**< @brief Set to \c 1 while history is being streamed. */
+static uint8_t streamDone = 0; /**< @brief Set to \c 1 when all samples are queued. Connection is terminated once queue is empty. */
+static uint8_t queued = 0; /**< @brief Number of notifications queued in SoftDevice and not sent yet. */
+
+
+// ----- STATIC FUNCTION DECLARATIONS
+static void start(void);
+static void send(void);
+static void onBLEEvent(ble_evt_t const* event, void* context);
+
+
+// ----- NAMESPACES
+/**
+ * @brief History GATT service namespace.
+ * 
+ */
+namespace History
+{
+	/**
+	 * @brief Init history GATT service.
+	 * 
+	 * @return \c Return_t::NOK on fail.
+	 * @return \c Return_t::OK on success.
+	 * 
+	 * @note SoftDevice must be enabled.
+	 */
+	Return_t init(void)
+	{
+		// Service
+		ble_uuid_t uuid;
+		ret_code_t ret = sd_ble_uuid_vs_add(&uuidBase, &uuid.type);
+		if (ret != NRF_SUCCESS)
+		{
+			APP_ERROR_CHECK(ret);
+			return Return_t::NOK;
+		}
+
+		uuid.uuid = uuidService;
+		ret = sd_ble_gatts_service_add(BLE_GATTS_SRVC_TYPE_PRIMARY, &uuid, &serviceHandle);
+		if (ret != NRF_SUCCESS)
+		{
+			APP_ERROR_CHECK(ret);
+			return Return_t::NOK;
+		}
+
+		// Notify only history characteristic
+		ble_gatts_attr_md_t cccdMeta;
+		memset(&cccdMeta, 0, sizeof(cccdMeta));
+		BLE_GAP_CONN_SEC_MODE_SET_OPEN(&cccdMeta.read_perm);
+		BLE_GAP_CONN_SEC_MODE_SET_OPEN(&cccdMeta.write_perm);
+		cccdMeta.vloc = BLE_GATTS_VLOC_STACK;
+
+		ble_gatts_char_md_t charMeta;
+		memset(&charMeta, 0, sizeof(charMeta));
+		charMeta.char_props.notify = 1;
+		charMeta.p_cccd_md = &cccdMeta;
+
+		ble_gatts_attr_md_t attrMeta;
+		memset(&attrMeta, 0, sizeof(attrMeta));
+		BLE_GAP_CONN_SEC_MODE_SET_OPEN(&attrMeta.read_perm);
+		BLE_GAP_CONN_SEC_MODE_SET_NO_ACCESS(&attrMeta.write_perm);
+		attrMeta.vloc = BLE_GATTS_VLOC_STACK;
+		attrMeta.vlen = 1;
+
+		uuid.uuid = uuidHistory;
+		ble_gatts_attr_t attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.p_uuid = &uuid;
+		attr.p_attr_md = &attrMeta;
+		attr.max_len = NRF_SDH_BLE_GATT_MAX_MTU_SIZE - 3;
+
+		ret = sd_ble_gatts_characteristic_add(serviceHandle, &charMeta, &attr, &historyHandles);
+		if (ret != NRF_SUCCESS)
+		{
+			APP_ERROR_CHECK(ret);
+			return Return_t::NOK;
+		}
+
+		NRF_SDH_BLE_OBSERVER(historyObserver, 3, onBLEEvent, NULL);
+
+		return Return_t::OK;
+	}
+};
+
+
+// ----- STATIC FUNCTION DEFINITIONS
+/**
+ * @brief Take history snapshot and start streaming.
+ * 
+ * @return No return value.
+ */
+static void start(void)
+{
+	const uint8_t count = Data::eeprom->historyCount;
+	const uint8_t head = Data::eeprom->historyHead % AppConfig::historySize;
+	const uint8_t first = (head + AppConfig::historySize - count) % AppConfig::historySize;
+
+	for (uint8_t i = 0; i < count; i++)
+	{
+		samples[i] = Data::eeprom->history[(first + i) % AppConfig::historySize];
+	}
+
+	sampleCount = count;
+	sampleIdx = 0;
+	streaming = 1;
+	streamDone = 0;
+	_PRINTF_INFO("History stream %u samples\n", sampleCount);
+
+	send();
+}
+
+/**
+ * @brief Queue notifications until SoftDevice queue is full or all samples are sent.
+ * 
+ * @return No return value.
+ */
+static void send(void)
+{
+	uint8_t buffer[NRF_SDH_BLE_GATT_MAX_MTU_SIZE - 3];
+	const uint16_t maxLen = BLE::getMTU() - 3;
+
+	while (streaming)
+	{
+		uint16_t len = 0;
+
+		// Number of samples goes only in first notification
+		if (!sampleIdx)
+		{
+			buffer[len++] = sampleCount;
+		}
+
+		uint8_t idx = sampleIdx;
+		while (idx < sampleCount && len + sizeof(samples[0]) <= maxLen)
+		{
+			buffer[len++] = samples[idx] & 0xFF;
+			buffer[len++] = samples[idx] >> 8;
+			idx++;
+		}
+
+		ble_gatts_hvx_params_t hvx;
+		memset(&hvx, 0, sizeof(hvx));
+		hvx.handle = historyHandles.value_handle;
+		hvx.type = BLE_GATT_HVX_NOTIFICATION;
+		hvx.p_len = &len;
+		hvx.p_data = buffer;
+
+		ret_code_t ret = sd_ble_gatts_hvx(BLE::getConnection(), &hvx);
+		if (ret == NRF_ERROR_RESOURCES)
+		{
+			// Queue is full, continue on TX complete event
+			return;
+		}
+
+		if (ret != NRF_SUCCESS)
+		{
+			_PRINTF_ERROR("History notify fail %lu\n", ret);
+			streaming = 0;
+			return;
+		}
+
+		queued++;
+		sampleIdx = idx;
+		if (sampleIdx >= sampleCount)
+		{
+			_PRINT_INFO("History stream done\n");
+			streaming = 0;
+			streamDone = 1;
+		}
+	}
+}
+
+/**
+ * @brief BLE stack event handler for history service.
+ * 
+ * @param event Pointer to event data.
+ * @param context Pointer to event context.
+ * 
+ * @return No return value.
+ */
+static void onBLEEvent(ble_evt_t const* event, void* context)
+{
+	switch (event->header.evt_id)
+	{
+		case BLE_GATTS_EVT_WRITE:
+		{
+			const ble_gatts_evt_write_t& write = event->evt.gatts_evt.params.write;
+			if (write.handle == historyHandles.cccd_handle && write.len == 2)
+			{
+				if (write.data[0] & BLE_GATT_HVX_NOTIFICATION)
+				{
+					start();
+				}
+				else
+				{
+					streaming = 0;
+				}
+			}
+			break;
+		}
+
+		case BLE_GATTS_EVT_HVN_TX_COMPLETE:
+		{
+			const uint8_t count = event->evt.gatts_evt.params.hvn_tx_complete.count;
+			queued = (queued > count) ? (queued - count) : 0;
+			send();
+
+			// Do not keep central connected after last notification is sent
+			if (streamDone && !queued)
+			{
+				streamDone = 0;
+				BLE::disconnect();
+			}
+			break;
+		}
+
+		case BLE_GAP_EVT_DISCONNECTED:
+		{
+			streaming = 0;
+			streamDone = 0;
+			queued = 0;
+			break;
+		}
+
+		default: break;
+	}
+}
+
+
+/** @} */
+
+// END WITH NEW LINE
@@ -34,6 +34,8 @@ namespace ADC
 {
 	Return_t init(void);
 	void measure(void);
+	void arm(void);
+	void disarm(void);
 	Return_t isDone(void);
 	uint16_t getVoltage(void);
 };
@@ -0,0 +1,47 @@
+/**
+ * @file Auth.hpp
+ * @author silvio3105 (www.github.com/silvio3105)
+ * @brief Payload authentication module header file.
+ * 
+ * @copyright Copyright (c) 2025, silvio3105
+ * 
+ */
+
+/*
+	Copyright (c) 2025, silvio3105 (www.github.com/silvio3105)
+
+	Access and use of this Project and its contents are granted free of charge to any Person.
+	The Person is allowed to copy, modify and use The Project and its contents only for non-commercial use.
+	Commercial use of this Project and its contents is prohibited.
+	Modifying this License and/or sublicensing is prohibited.
+
+	THE PROJECT AND ITS CONTENT ARE PROVIDED "AS IS" WITH ALL FAULTS AND WITHOUT EXPRESSED OR IMPLIED WARRANTY.
+	THE AUTHOR KEEPS ALL RIGHTS TO CHANGE OR REMOVE THE CONTENTS OF THIS PROJECT WITHOUT PREVIOUS NOTICE.
+	THE AUTHOR IS NOT RESPONSIBLE FOR DAMAGE OF ANY KIND OR LIABILITY CAUSED BY USING THE CONTENTS OF THIS PROJECT.
+
+	This License shall be included in all functional textual files.
+*/
+
+#ifndef _AUTH_HPP_
+#define _AUTH_HPP_
+
+// ----- INCLUDE FILES
+#include			"Main.hpp"
+
+
+// ----- NAMESPACES
+namespace Auth
+{
+	// ----- VARIABLES
+	static constexpr uint8_t size = AppConfig::authPayload ? (1 + AppConfig::authTagSize) : 0; /**< @brief Size of authentication trailer in bytes. Counter low byte and truncated tag. */
+
+
+	// ----- FUNCTION DECLARATIONS
+	Return_t init(void);
+	Return_t sign(uint8_t* payload, const uint8_t len);
+};
+
+
+#endif // _AUTH_HPP_
+
+// END WITH NEW LINE
@@ -32,11 +32,30 @@
 // ----- NAMESPACES
 namespace BLE
 {
+	// ----- ENUMS
+	/**
+	 * @brief Enum class with advertise types.
+	 * 
+	 */
+	enum class Adv_t : uint8_t
+	{
+		Normal = 0, /**< @brief Single advertise event on \ref AppConfig::advChannels primary channels. */
+		AllChannels, /**< @brief Single advertise event on all primary channels. */
+		Alarm, /**< @brief Burst of \ref AppConfig::alarmAdvCount advertise events on all primary channels. */
+		Connectable, /**< @brief Connectable window of \ref AppConfig::connAdvCount advertise events on all primary channels. */
+	};
+
+
 	// ----- FUNCTION DECLARATIONS
-	Return_t init(void);
+	Return_t init(const void* data, const uint8_t len, const void* scan, const uint8_t scanLen);
 	Return_t deinit(void);
-	Return_t advertise(const void* data, const uint8_t len);
+	Return_t advertise(const void* data, const uint8_t len, const void* scan, const uint8_t scanLen, const Adv_t type);
 	Return_t isAdvertiseDone(void);
+	uint8_t getChannels(void);
+	uint8_t isConnected(void);
+	Return_t disconnect(void);
+	uint16_t getConnection(void);
+	uint16_t getMTU(void);
 };
 
 
@@ -32,6 +32,7 @@
 #include			<stdint.h>
 #include			<string.h>
 #include			<stdio.h>
+#include			<stdlib.h>
 
 /**
  * @addtogroup Data
@@ -94,11 +95,23 @@ namespace Data
 		System::Reset_t rstReason; /**< @brief Reset reason. */
 		uint8_t _padding2; // Padding byte
 		uint16_t workingSeconds; /**< @brief Working seconds counter. */
+
+		uint32_t advSent; /**< @brief Number of advertised measurements. */
+		uint32_t advSkipped; /**< @brief Number of measurements not advertised because data did not change. */
+		uint32_t alarmCnt; /**< @brief Number of raised alarms. */
+		uint32_t storageCnt; /**< @brief Number of storage mode entries. */
+		uint32_t authCounter; /**< @brief Payload authentication counter. */
+		uint32_t advPackets[3]; /**< @brief Number of advertise events per primary channel 37, 38 and 39. */
+
+		uint8_t historyHead; /**< @brief Index of next pressure history entry. */
+		uint8_t historyCount; /**< @brief Number of valid pressure history entries. */
+		uint16_t history[AppConfig::historySize]; /**< @brief Pressure history ring in mbar. */
 	};
 
 
 	// ----- VARAIBLES	
 	static EEPROM_s* eeprom = (EEPROM_s*)MemoryMap::sramEEPROMStart; /**< @brief Reference to EEPROM in SRAM. */
+	static_assert(sizeof(EEPROM_s) <= MemoryMap::sramEEPROMSize, "SRAM EEPROM data does not fit");
 
 
 	// ----- CLASSES
@@ -220,6 +233,18 @@ namespace Data
 		{
 			errorCode = Error_t::None;
 		}
+
+		/**
+		 * @brief Set alarm state.
+		 * 
+		 * @param state Set to \c 1 if alarm is active.
+		 * 
+		 * @return No return value.
+		 */
+		inline void setAlarm(const uint8_t state)
+		{
+			alarm = state;
+		}
 		
 		/**
 		 * @brief Set device firmware version.
@@ -258,10 +283,147 @@ namespace Data
 		 * @param measurePeriod Measure period in seconds.
 		 * 
 		 * @return No return value.
+		 * 
+		 * @note Period is rounded up to \ref cfgPeriodRes, so period shorter than resolution is not sent as \c 0
 		 */
 		inline void setConfig(const AppConfig::Hardware_t hwID, const uint8_t measurePeriod)
 		{
-			config = ((uint8_t)hwID << cfgHWIDBit) | ((measurePeriod / cfgPeriodRes) << cfgPeriodBit);
+			config = ((uint8_t)hwID << cfgHWIDBit) | (((measurePeriod + cfgPeriodRes - 1) / cfgPeriodRes) << cfgPeriodBit);
+		}
+
+		/**
+		 * @brief Get pressure.
+		 * 
+		 * @return Pressure in mbar.
+		 */
+		inline uint16_t getPressure(void) const
+		{
+			return pressure;
+		}
+
+		/**
+		 * @brief Get temperature.
+		 * 
+		 * @return Temperature in centi degrees Celsius.
+		 */
+		inline int16_t getTemperature(void) const
+		{
+			return temperature;
+		}
+
+		/**
+		 * @brief Get battery voltage.
+		 * 
+		 * @return Battery voltage in centivolts with offset of 200cV.
+		 */
+		inline uint8_t getVoltage(void) const
+		{
+			return voltage;
+		}
+
+		/**
+		 * @brief Get active errors.
+		 * 
+		 * @return Active errors. See \ref Error_t
+		 */
+		inline Error_t getErrorCode(void) const
+		{
+			return errorCode;
+		}
+
+		/**
+		 * @brief Check if alarm is active.
+		 * 
+		 * @return \c 1 if alarm is active, \c 0 otherwise.
+		 */
+		inline uint8_t isAlarm(void) const
+		{
+			return alarm;
+		}
+
+		/**
+		 * @brief Get device uptime.
+		 * 
+		 * @return Device uptime in hours.
+		 */
+		inline uint16_t getUptime(void) const
+		{
+			return uptime;
+		}
+
+		/**
+		 * @brief Get device firmware version.
+		 * 
+		 * @param idx Version part index (0 = major, 1 = minor, 2 = build).
+		 * 
+		 * @return Version number.
+		 */
+		inline uint8_t getFirmwareVersion(const uint8_t idx) const
+		{
+			return fwVer[idx];
+		}
+
+		/**
+		 * @brief Get reset reason.
+		 * 
+		 * @return Reset reason. See \ref System::Reset_t
+		 */
+		inline System::Reset_t getResetReason(void) const
+		{
+			return rstReason;
+		}
+
+		/**
+		 * @brief Get reset count.
+		 * 
+		 * @return Reset count.
+		 */
+		inline uint8_t getResetCount(void) const
+		{
+			return rstCount;
+		}
+
+		/**
+		 * @brief Get device config.
+		 * 
+		 * @return Device config. See \ref config
+		 */
+		inline uint8_t getConfig(void) const
+		{
+			return config;
+		}
+
+		/**
+		 * @brief Check if data changed enough to be advertised.
+		 * 
+		 * @param last Reference to last advertised data.
+		 * 
+		 * @return \c 1 if any value is out of its deadband or error code or reset changed, \c 0 otherwise.
+		 */
+		inline uint8_t isChanged(const sTPMS& last) const
+		{
+			return (abs(pressure - last.pressure) > AppConfig::advPressureDeadband ||
+					abs(temperature - last.temperature) > AppConfig::advTemperatureDeadband ||
+					abs(voltage - last.voltage) > AppConfig::advVoltageDeadband ||
+					errorCode != last.errorCode ||
+					alarm != last.alarm ||
+					rstReason != last.rstReason ||
+					rstCount != last.rstCount);
+		}
+
+		/**
+		 * @brief Check if diagnostic fields of full frame changed.
+		 * 
+		 * @param last Reference to data sent in last full frame.
+		 * 
+		 * @return \c 1 if firmware version, reset or config changed, \c 0 otherwise.
+		 */
+		inline uint8_t isDiagChanged(const sTPMS& last) const
+		{
+			return (memcmp(fwVer, last.fwVer, sizeof(fwVer)) != 0 ||
+					rstReason != last.rstReason ||
+					rstCount != last.rstCount ||
+					config != last.config);
 		}
 
 
@@ -284,6 +446,7 @@ namespace Data
 		uint16_t uptime; /**< @brief Device uptime in hours. */
 		uint8_t voltage; /**< @brief Battery voltage in centivolts. Offset: 200cV. */
 		Error_t errorCode; /**< @brief Last error code. See \ref Error_t. */
+		uint8_t alarm; /**< @brief Alarm state. \c 1 if pressure is below \ref AppConfig::alarmPressure or drops faster than \ref AppConfig::alarmDropRate */
 
 		uint8_t fwVer[3]; /**< @brief Firmware version - major, minor, build. */
 		System::Reset_t rstReason; /**< @brief Reset reason. See \ref System::Reset_t. */
@@ -300,6 +463,30 @@ namespace Data
 
 
 	// ----- FUNCTION DEFINITIONS
+	/**
+	 * @brief Add pressure sample to history in SRAM EEPROM.
+	 * 
+	 * @param pressure Pressure in mbar.
+	 * 
+	 * @return No return value.
+	 */
+	inline void addHistory(const uint16_t pressure)
+	{
+		const uint8_t head = eeprom->historyHead % AppConfig::historySize;
+
+		eeprom->history[head] = pressure;
+		eeprom->historyHead = (head + 1) % AppConfig::historySize;
+
+		if (eeprom->historyCount < AppConfig::historySize)
+		{
+			eeprom->historyCount++;
+		}
+		else
+		{
+			eeprom->historyCount = AppConfig::historySize;
+		}
+	}
+
 	/**
 	 * @brief Init SRAM EEPROM.
 	 * 
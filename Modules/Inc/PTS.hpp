@@ -34,7 +34,9 @@ namespace PTS
 {
 	// ----- FUNCTION DECLARATIONS
 	Return_t init(void);
-	Return_t measure(void);
+	Return_t start(void);
+	Return_t read(void);
+	Return_t powerDown(void);
 	uint16_t getPressure(void);
 	int16_t getTemperature(void);
 };
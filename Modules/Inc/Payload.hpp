@@ -0,0 +1,287 @@
+/**
+ * @file Payload.hpp
+ * @author silvio3105 (www.github.com/silvio3105)
+ * @brief Advertise payload format header file.
+ * 
+ * @copyright Copyright (c) 2025, silvio3105
+ * 
+ */
+
+/*
+	Copyright (c) 2025, silvio3105 (www.github.com/silvio3105)
+
+	Access and use of this Project and its contents are granted free of charge to any Person.
+	The Person is allowed to copy, modify and use The Project and its contents only for non-commercial use.
+	Commercial use of this Project and its contents is prohibited.
+	Modifying this License and/or sublicensing is prohibited.
+
+	THE PROJECT AND ITS CONTENT ARE PROVIDED "AS IS" WITH ALL FAULTS AND WITHOUT EXPRESSED OR IMPLIED WARRANTY.
+	THE AUTHOR KEEPS ALL RIGHTS TO CHANGE OR REMOVE THE CONTENTS OF THIS PROJECT WITHOUT PREVIOUS NOTICE.
+	THE AUTHOR IS NOT RESPONSIBLE FOR DAMAGE OF ANY KIND OR LIABILITY CAUSED BY USING THE CONTENTS OF THIS PROJECT.
+
+	This License shall be included in all functional textual files.
+*/
+
+#ifndef _PAYLOAD_HPP_
+#define _PAYLOAD_HPP_
+
+// ----- INCLUDE FILES
+#include			"Data.hpp"
+
+#include			<stdint.h>
+#include			<string.h>
+
+
+/**
+ * @addtogroup Payload
+ * 
+ * Bit-packed advertise payload.
+ * Payload layout is described only by \ref Payload::fields table, encoder and decoder are both driven by it.
+ * Fields are packed LSB first, starting from bit 0 of byte 0.
+ * @{
+ */
+
+
+// ----- NAMESPACES
+/**
+ * @brief Advertise payload namespace.
+ * 
+ */
+namespace Payload
+{
+	// ----- ENUMS
+	/**
+	 * @brief Enum class with payload frame types.
+	 * 
+	 */
+	enum class Frame_t : uint8_t
+	{
+		Measure = 0, /**< @brief Frame with measurement fields only. */
+		Full = 1, /**< @brief Frame with measurement and diagnostic fields. */
+	};
+
+	/**
+	 * @brief Enum class with payload fields in on-air order.
+	 * 
+	 */
+	enum class Field_t : uint8_t
+	{
+		Version = 0, /**< @brief Payload format version. */
+		Type, /**< @brief Frame type. See \ref Frame_t */
+		Flags, /**< @brief Status flags. Bit 0 is alarm. */
+		Sequence, /**< @brief Advertise sequence number. */
+		Pressure, /**< @brief Pressure in mbar. */
+		Temperature, /**< @brief Temperature in centi degrees Celsius. */
+		Voltage, /**< @brief Battery voltage in centivolts with offset of 200cV. */
+		Error, /**< @brief Active errors. See \ref Data::Error_t */
+		FirmwareMajor, /**< @brief Firmware major version. First diagnostic field. */
+		FirmwareMinor, /**< @brief Firmware minor version. */
+		FirmwareBuild, /**< @brief Firmware build version. */
+		ResetReason, /**< @brief Reset reason. See \ref System::Reset_t */
+		ResetCount, /**< @brief Reset count. */
+		Config, /**< @brief Device config. */
+		Uptime, /**< @brief Device uptime in hours. */
+
+		Count /**< @brief Number of fields. Must be last. */
+	};
+
+
+	// ----- STRUCTS
+	/**
+	 * @brief Payload field description struct.
+	 * 
+	 * Raw field value is <tt>(value - offset) / divider</tt>, clamped to \c bits wide unsigned range.
+	 * 
+	 */
+	struct Field_s
+	{
+		uint8_t bits; /**< @brief Field width in bits. */
+		int16_t offset; /**< @brief Value offset. */
+		uint8_t divider; /**< @brief Value resolution divider. */
+	};
+
+
+	// ----- VARIABLES
+	static constexpr uint8_t version = 1; /**< @brief Payload format version. Increase on every change of \ref fields */
+
+	static constexpr Field_s fields[] = /**< @brief Payload field table in \ref Field_t order. */
+	{
+		{ 4, 0, 1 }, // Version
+		{ 2, 0, 1 }, // Type
+		{ 1, 0, 1 }, // Flags
+		{ 5, 0, 1 }, // Sequence
+		{ 12, 0, 1 }, // Pressure, 0 - 4095mbar
+		{ 11, -4000, 10 }, // Temperature, -40.0 - 164.7degC in 0.1degC
+		{ 8, 0, 1 }, // Voltage
+		{ 5, 0, 1 }, // Error
+		{ 8, 0, 1 }, // FirmwareMajor
+		{ 8, 0, 1 }, // FirmwareMinor
+		{ 8, 0, 1 }, // FirmwareBuild
+		{ 8, 0, 1 }, // ResetReason
+		{ 8, 0, 1 }, // ResetCount
+		{ 8, 0, 1 }, // Config
+		{ 16, 0, 1 } // Uptime
+	};
+	static_assert(sizeof(fields) / sizeof(fields[0]) == (uint8_t)Field_t::Count, "Payload field table does not match Field_t");
+
+
+	// ----- FUNCTION DEFINITIONS
+	/**
+	 * @brief Get number of fields in frame.
+	 * 
+	 * @param frame Frame type. See \ref Frame_t
+	 * 
+	 * @return Number of fields.
+	 */
+	constexpr uint8_t getFieldCount(const Frame_t frame)
+	{
+		return (frame == Frame_t::Measure) ? (uint8_t)Field_t::FirmwareMajor : (uint8_t)Field_t::Count;
+	}
+
+	/**
+	 * @brief Get frame size.
+	 * 
+	 * @param frame Frame type. See \ref Frame_t
+	 * 
+	 * @return Frame size in bytes.
+	 */
+	constexpr uint8_t getSize(const Frame_t frame)
+	{
+		uint16_t bits = 0;
+		for (uint8_t i = 0; i < getFieldCount(frame); i++)
+		{
+			bits += fields[i].bits;
+		}
+
+		return (bits + 7) / 8;
+	}
+
+	/**
+	 * @brief Get maximum raw value of field.
+	 * 
+	 * @param field Payload field. See \ref Field_t
+	 * 
+	 * @return Maximum raw value.
+	 */
+	constexpr uint32_t getMax(const Field_t field)
+	{
+		return (1UL << fields[(uint8_t)field].bits) - 1;
+	}
+
+	static constexpr uint8_t maxSize = getSize(Frame_t::Full); /**< @brief Size of largest frame in bytes. */
+
+	/**
+	 * @brief Pack values into frame.
+	 * 
+	 * @param output Pointer to output buffer of at least \ref getSize bytes.
+	 * @param values Pointer to field values in \ref Field_t order.
+	 * @param frame Frame type. See \ref Frame_t
+	 * 
+	 * @return Frame size in bytes.
+	 */
+	inline uint8_t pack(uint8_t* output, const int32_t* values, const Frame_t frame)
+	{
+		const uint8_t size = getSize(frame);
+		memset(output, 0, size);
+
+		uint16_t bit = 0;
+		for (uint8_t i = 0; i < getFieldCount(frame); i++)
+		{
+			const uint32_t max = getMax((Field_t)i);
+			int32_t raw = (values[i] - fields[i].offset) / fields[i].divider;
+			if (raw < 0)
+			{
+				raw = 0;
+			}
+			else if ((uint32_t)raw > max)
+			{
+				raw = max;
+			}
+
+			for (uint8_t b = 0; b < fields[i].bits; b++, bit++)
+			{
+				output[bit / 8] |= ((raw >> b) & 1) << (bit % 8);
+			}
+		}
+
+		return size;
+	}
+
+	/**
+	 * @brief Unpack frame into values.
+	 * 
+	 * @param values Pointer to output for field values in \ref Field_t order. Must hold \ref Field_t::Count values.
+	 * @param input Pointer to frame.
+	 * @param len Length of \c input
+	 * 
+	 * @return Number of unpacked fields, \c 0 if frame version or size is not supported.
+	 */
+	inline uint8_t unpack(int32_t* values, const uint8_t* input, const uint8_t len)
+	{
+		if (!len || (input[0] & getMax(Field_t::Version)) != version)
+		{
+			return 0;
+		}
+
+		const Frame_t frame = (Frame_t)((input[0] >> fields[(uint8_t)Field_t::Version].bits) & getMax(Field_t::Type));
+		if (frame > Frame_t::Full || len < getSize(frame))
+		{
+			return 0;
+		}
+
+		uint16_t bit = 0;
+		for (uint8_t i = 0; i < getFieldCount(frame); i++)
+		{
+			uint32_t raw = 0;
+			for (uint8_t b = 0; b < fields[i].bits; b++, bit++)
+			{
+				raw |= (uint32_t)((input[bit / 8] >> (bit % 8)) & 1) << b;
+			}
+
+			values[i] = (int32_t)raw * fields[i].divider + fields[i].offset;
+		}
+
+		return getFieldCount(frame);
+	}
+
+	/**
+	 * @brief Encode sTPMS data into frame.
+	 * 
+	 * @param output Pointer to output buffer of at least \ref getSize bytes.
+	 * @param data Reference to sTPMS data.
+	 * @param frame Frame type. See \ref Frame_t
+	 * @param sequence Advertise sequence number.
+	 * 
+	 * @return Frame size in bytes.
+	 */
+	inline uint8_t encode(uint8_t* output, const Data::sTPMS& data, const Frame_t frame, const uint8_t sequence)
+	{
+		const int32_t values[(uint8_t)Field_t::Count] =
+		{
+			version,
+			(int32_t)frame,
+			data.isAlarm(),
+			sequence,
+			data.getPressure(),
+			data.getTemperature(),
+			data.getVoltage(),
+			(int32_t)data.getErrorCode(),
+			data.getFirmwareVersion(0),
+			data.getFirmwareVersion(1),
+			data.getFirmwareVersion(2),
+			(int32_t)data.getResetReason(),
+			data.getResetCount(),
+			data.getConfig(),
+			data.getUptime()
+		};
+
+		return pack(output, values, frame);
+	}
+};
+
+
+/** @} */
+
+#endif // _PAYLOAD_HPP_
+
+// END WITH NEW LINE
@@ -0,0 +1,62 @@
+/**
+ * @file Power.hpp
+ * @author silvio3105 (www.github.com/silvio3105)
+ * @brief Peripheral power domain module header file.
+ * 
+ * @copyright Copyright (c) 2025, silvio3105
+ * 
+ */
+
+/*
+	Copyright (c) 2025, silvio3105 (www.github.com/silvio3105)
+
+	Access and use of this Project and its contents are granted free of charge to any Person.
+	The Person is allowed to copy, modify and use The Project and its contents only for non-commercial use.
+	Commercial use of this Project and its contents is prohibited.
+	Modifying this License and/or sublicensing is prohibited.
+
+	THE PROJECT AND ITS CONTENT ARE PROVIDED "AS IS" WITH ALL FAULTS AND WITHOUT EXPRESSED OR IMPLIED WARRANTY.
+	THE AUTHOR KEEPS ALL RIGHTS TO CHANGE OR REMOVE THE CONTENTS OF THIS PROJECT WITHOUT PREVIOUS NOTICE.
+	THE AUTHOR IS NOT RESPONSIBLE FOR DAMAGE OF ANY KIND OR LIABILITY CAUSED BY USING THE CONTENTS OF THIS PROJECT.
+
+	This License shall be included in all functional textual files.
+*/
+
+#ifndef _POWER_HPP_
+#define _POWER_HPP_
+
+// ----- INCLUDE FILES
+#include			"Main.hpp"
+
+
+// ----- NAMESPACES
+namespace Power
+{
+	// ----- ENUMS
+	/**
+	 * @brief Enum class with peripheral power domains.
+	 * 
+	 * \ingroup Power
+	 */
+	enum class Domain_t : uint8_t
+	{
+		TWIM = 0, /**< @brief \c TWIM0 and \c TIMER1 list counter. */
+		SAADC, /**< @brief \c SAADC */
+		PTSSelect, /**< @brief Pressure and temperature sensor select GPIO. */
+
+		Count /**< @brief Number of power domains. Must be last. */
+	};
+
+
+	// ----- FUNCTION DECLARATIONS
+	void acquire(const Domain_t domain);
+	void release(const Domain_t domain);
+	void flush(void);
+	uint8_t isOn(const Domain_t domain);
+	void report(void);
+};
+
+
+#endif // _POWER_HPP_
+
+// END WITH NEW LINE
@@ -0,0 +1,81 @@
+/**
+ * @file Scheduler.hpp
+ * @author silvio3105 (www.github.com/silvio3105)
+ * @brief Event scheduler module header file.
+ * 
+ * @copyright Copyright (c) 2025, silvio3105
+ * 
+ */
+
+/*
+	Copyright (c) 2025, silvio3105 (www.github.com/silvio3105)
+
+	Access and use of this Project and its contents are granted free of charge to any Person.
+	The Person is allowed to copy, modify and use The Project and its contents only for non-commercial use.
+	Commercial use of this Project and its contents is prohibited.
+	Modifying this License and/or sublicensing is prohibited.
+
+	THE PROJECT AND ITS CONTENT ARE PROVIDED "AS IS" WITH ALL FAULTS AND WITHOUT EXPRESSED OR IMPLIED WARRANTY.
+	THE AUTHOR KEEPS ALL RIGHTS TO CHANGE OR REMOVE THE CONTENTS OF THIS PROJECT WITHOUT PREVIOUS NOTICE.
+	THE AUTHOR IS NOT RESPONSIBLE FOR DAMAGE OF ANY KIND OR LIABILITY CAUSED BY USING THE CONTENTS OF THIS PROJECT.
+
+	This License shall be included in all functional textual files.
+*/
+
+#ifndef _SCHEDULER_HPP_
+#define _SCHEDULER_HPP_
+
+// ----- INCLUDE FILES
+#include			"Main.hpp"
+
+
+// ----- NAMESPACES
+namespace Scheduler
+{
+	// ----- ENUMS
+	/**
+	 * @brief Enum class with scheduler events.
+	 * 
+	 * Lower value means higher priority when multiple events are pending.
+	 * 
+	 * \ingroup Scheduler
+	 */
+	enum class Event_t : uint8_t
+	{
+		Watchdog = 0, /**< @brief Watchdog feed timer expired. */
+		Uptime, /**< @brief Uptime timer expired. */
+		Battery, /**< @brief Battery measure timer expired. */
+		Heartbeat, /**< @brief Heartbeat advertise timer expired. */
+		Wakeup, /**< @brief Measure wakeup timer expired. */
+		Measure, /**< @brief Start measure cycle. */
+		ADCDone, /**< @brief \c SAADC finished battery measurement. */
+		PTSReady, /**< @brief Pressure and temperature sensor conversion should be done. */
+		Advertise, /**< @brief All measurements are done, advertise data. */
+		AdvertiseDone, /**< @brief SoftDevice finished advertise set. */
+
+		Count /**< @brief Number of events. Must be last. */
+	};
+
+
+	// ----- TYPEDEFS
+	/**
+	 * @brief Typedef for run-to-completion task handler.
+	 * 
+	 * \ingroup Scheduler
+	 */
+	typedef void (*Task_f)(void);
+
+
+	// ----- FUNCTION DECLARATIONS
+	void init(void);
+	void subscribe(const Event_t event, const Task_f task);
+	void post(const Event_t event);
+	Return_t run(void);
+	void idle(void);
+	void report(void);
+};
+
+
+#endif // _SCHEDULER_HPP_
+
+// END WITH NEW LINE
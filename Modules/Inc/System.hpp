@@ -63,14 +63,15 @@ namespace System
 		PTSInit = 23, /**< @brief Reset reason for failed sensor init. */
 		TWIInit = 24, /**< @brief Reset reason for failed TWI init. */
 		AdvFail = 25, /**< @brief Reset reason for too much BLE advertise fails. */
+		AuthInit = 26, /**< @brief Reset reason for failed payload authentication init. */
+		HistoryInit = 27, /**< @brief Reset reason for failed history service init. */
 	};
 
 	
 	// ----- FUNCTION DECLARATION
 	Return_t init(void);
-	void startWakeupTimer(const uint8_t period);
-	Return_t isWoken(void);
 	void sleep(void);
+	void off(void);
 	Reset_t getResetReason(void);
 	void reset(const Reset_t reason);
 	
@@ -32,11 +32,32 @@
 // ----- NAMESPACES
 namespace TWI
 {
+	// ----- TYPEDEFS
+	/**
+	 * @brief Typedef for transfer done callback.
+	 * 
+	 * @param status \c Return_t::OK if transfer was successful.
+	 * 
+	 * @return No return value.
+	 * 
+	 * @note Called from \c TWI0 interrupt.
+	 * 
+	 * \ingroup TWI
+	 */
+	typedef void (*Callback_f)(const Return_t status);
+
+
 	// ----- FUNCTION DECLARATIONS
 	Return_t init(void);
 	Return_t deinit(void);
+	Return_t transfer(const uint8_t address, const void* txData, const uint16_t txLen, void* rxData, const uint16_t rxLen, const Callback_f callback);
+	Return_t transferList(const uint8_t address, const void* txList, const uint8_t txLen, void* rxList, const uint8_t rxLen, const uint8_t count, const Callback_f callback);
+	Return_t wait(void);
 	Return_t write(const uint8_t address, const void* data, const uint16_t len);
 	Return_t read(const uint8_t address, void* output, const uint16_t len);
+	Return_t writeRead(const uint8_t address, const void* txData, const uint16_t txLen, void* rxData, const uint16_t rxLen);
+	uint16_t getTransferCount(void);
+	void clearTransferCount(void);
 };
 
 
@@ -0,0 +1,51 @@
+/**
+ * @file Timer.hpp
+ * @author silvio3105 (www.github.com/silvio3105)
+ * @brief Software timer module header file.
+ * 
+ * @copyright Copyright (c) 2025, silvio3105
+ * 
+ */
+
+/*
+	Copyright (c) 2025, silvio3105 (www.github.com/silvio3105)
+
+	Access and use of this Project and its contents are granted free of charge to any Person.
+	The Person is allowed to copy, modify and use The Project and its contents only for non-commercial use.
+	Commercial use of this Project and its contents is prohibited.
+	Modifying this License and/or sublicensing is prohibited.
+
+	THE PROJECT AND ITS CONTENT ARE PROVIDED "AS IS" WITH ALL FAULTS AND WITHOUT EXPRESSED OR IMPLIED WARRANTY.
+	THE AUTHOR KEEPS ALL RIGHTS TO CHANGE OR REMOVE THE CONTENTS OF THIS PROJECT WITHOUT PREVIOUS NOTICE.
+	THE AUTHOR IS NOT RESPONSIBLE FOR DAMAGE OF ANY KIND OR LIABILITY CAUSED BY USING THE CONTENTS OF THIS PROJECT.
+
+	This License shall be included in all functional textual files.
+*/
+
+#ifndef _TIMER_HPP_
+#define _TIMER_HPP_
+
+// ----- INCLUDE FILES
+#include			"Main.hpp"
+#include			"Scheduler.hpp"
+
+
+// ----- NAMESPACES
+namespace Timer
+{
+	// ----- VARIABLES
+	static constexpr uint16_t tickRate = 1024; /**< @brief Timer tick rate in Hz. */
+
+
+	// ----- FUNCTION DECLARATIONS
+	Return_t init(void);
+	void start(const Scheduler::Event_t event, const uint32_t delay, const uint32_t period);
+	void stop(const Scheduler::Event_t event);
+	uint8_t isActive(const Scheduler::Event_t event);
+	uint32_t getTick(void);
+};
+
+
+#endif // _TIMER_HPP_
+
+// END WITH NEW LINE
@@ -28,26 +28,86 @@
 #include 			"ILPS22QS.hpp"
 #include			"System.hpp"
 #include			"Data.hpp"
+#include			"Power.hpp"
+#include			"Timer.hpp"
 
-#include			"nrf_gpio.h"
+#include			"nrf_soc.h"
 
 /**
  * @addtogroup PTS 
  * 
  * Pressure Temperature Sensor module for ILPS22QS sensor.
+ * With \c AppConfig::ptsFIFO sensor samples continuously into its FIFO and each measure cycle drains collected samples into pressure history.
  * @{
  */
 
 // ----- STATIC FUNCTION DECLARATIONS
-ILPS22QS::Return_t read(const uint8_t address, void* data, const uint8_t len, const uint8_t timeout);
-ILPS22QS::Return_t write(const uint8_t address, void* data, const uint8_t len, const uint8_t timeout);
-ILPS22QS::Return_t msp(void);
+static Return_t readFIFO(void);
+#ifndef ILPS22QS_SYNC
+static void onTransferDone(const Return_t status);
+#endif // ILPS22QS_SYNC
+
+
+// ----- STRUCTS
+/**
+ * @brief TWI bus policy for ILPS22QS driver.
+ * 
+ * Handlers are bound to the driver during compile. See \ref ILPS22QS::I2CBus
+ */
+struct SensorBus
+{
+	static ILPS22QS::Return_t read(const uint8_t address, void* data, const uint8_t len, const uint8_t timeout);
+	static ILPS22QS::Return_t write(const uint8_t address, void* data, const uint8_t len, const uint8_t timeout);
+	static ILPS22QS::Return_t writeRead(const uint8_t address, const void* txData, const uint8_t txLen, void* rxData, const uint8_t rxLen, const uint8_t timeout);
+	static ILPS22QS::Return_t writeList(const uint8_t address, const void* list, const uint8_t entryLen, const uint8_t count, const uint8_t timeout);
+	static ILPS22QS::Return_t mspInit(void);
+	static ILPS22QS::Return_t mspDeinit(void);
+	static void delay(const uint32_t period);
+	static ILPS22QS::Return_t getTick(uint32_t& output);
+};
 
 
 // ----- VARIABLES
-ILPS22QS::I2C Sensor = ILPS22QS::I2C(read, write, msp, msp); /**< @brief ILPS22QS object. */
+static ILPS22QS::I2CBus<SensorBus> Sensor; /**< @brief ILPS22QS object. */
 static uint16_t pressure = 0; /**< @brief Measured pressure in mbar. */
 static int16_t temperature = 0; /**< @brief Measured temperature in centi degrees Celsius. */
+static uint8_t selectHeld = 0; /**< @brief Set to \c 1 while sensor holds select pin power domain. */
+static uint8_t readRetries = 0; /**< @brief Number of data status checks which found no new data. */
+static constexpr uint8_t maxReadRetries = 3; /**< @brief Maximum number of data status checks before measure fails. */
+static constexpr uint8_t retryDelay = 1; /**< @brief Delay in ms before data status is checked again. */
+static constexpr uint8_t fifoBatch = 32; /**< @brief Maximum number of FIFO samples read in single bus transfer. */
+static constexpr uint8_t oneShot = !AppConfig::ptsFIFO; /**< @brief Sensor converts only on request, otherwise it samples continuously. */
+static constexpr uint16_t fifoWatermark = AppConfig::parkedPeriod * AppConfig::ptsFIFORate; /**< @brief Number of FIFO samples collected between two measurements. */
+static_assert(AppConfig::ptsFIFODepth == ILPS22QS::fifoDepth, "FIFO depth in config must match sensor FIFO");
+static_assert(!AppConfig::ptsFIFO || fifoWatermark <= ILPS22QS::fifoDepth, "FIFO samples between two measurements must fit in sensor FIFO, shorten longest period or lower FIFO rate");
+static uint8_t fifoRaw[fifoBatch * ILPS22QS::fifoSampleSize]; /**< @brief Raw FIFO data buffer. */
+static uint16_t fifoSamples[fifoBatch]; /**< @brief Pressure samples read from FIFO. */
+static const ILPS22QS::FIFOConfig_s fifoCfg = /**< @brief Sensor FIFO config. Watermark matches wakeup period since sensor has no interrupt pin. */
+{
+	.mode = ILPS22QS::FIFOMode_t::Continuous,
+	.watermark = (fifoWatermark < ILPS22QS::fifoDepth) ? (uint8_t)fifoWatermark : (uint8_t)(ILPS22QS::fifoDepth - 1),
+	.stopOnWatermark = ILPS22QS::State_t::Disable
+};
+static const ILPS22QS::Config_s sensorCfg = /**< @brief Sensor config. */
+{
+	.dataOutput =
+	{
+		.dataRate = oneShot ? ILPS22QS::OutputDataRate_t::OneShot :
+					(AppConfig::ptsFIFORate >= 10) ? ILPS22QS::OutputDataRate_t::ODR10Hz :
+					(AppConfig::ptsFIFORate >= 4) ? ILPS22QS::OutputDataRate_t::ODR4Hz : ILPS22QS::OutputDataRate_t::ODR1Hz,
+		.average = ILPS22QS::Average_t::Average16
+	},
+
+	.filter =
+	{
+		.discard = ILPS22QS::FilterDiscard_t::Discard6Samples,
+		.filter = ILPS22QS::State_t::Enable
+	},
+
+	.pressureScale = ILPS22QS::PressureScale_t::Scale4060hPa,
+	.dataUpdate = ILPS22QS::DataUpdate_t::Continuous,
+	.analogHub = ILPS22QS::State_t::Disable
+};
 
 
 // ----- EXTERNS
@@ -77,62 +137,72 @@ namespace PTS
 			return Return_t::NOK;
 		}
 
-		// Configure PTS
-		if (Sensor.disableAnalogHub() != ILPS22QS::Return_t::OK)
+		// Configure PTS with single TWI list job
+		if (Sensor.configure(sensorCfg) != ILPS22QS::Return_t::OK)
 		{	
-			_PRINT_ERROR("Analog hub disable fail\n");
+			_PRINT_ERROR("Sensor config fail\n");
 			return Return_t::NOK;
 		}
 
-		if (Sensor.setPressureScale(ILPS22QS::PressureScale_t::Scale4060hPa) != ILPS22QS::Return_t::OK)
+		if (AppConfig::ptsFIFO && Sensor.setFIFOConfig(fifoCfg) != ILPS22QS::Return_t::OK)
 		{
-			_PRINT_ERROR("Pressure scale set fail\n");
+			_PRINT_ERROR("FIFO config fail\n");
 			return Return_t::NOK;
 		}
 
-		static const ILPS22QS::FilterConfig_s filterCfg =
-		{	
-			.discard = ILPS22QS::FilterDiscard_t::Discard6Samples,
-			.filter = ILPS22QS::State_t::Enable
-		};
-		if (Sensor.setFilterConfig(filterCfg) != ILPS22QS::Return_t::OK)
+		return Return_t::OK;
+	}
+
+	/**
+	 * @brief Start pressure and temperature one-shot measurement.
+	 * 
+	 * Sensor converts in background while one-shot timer times the conversion. 
+	 * \ref Scheduler::Event_t::PTSReady is posted when the conversion should be done, use \ref read to fetch the result.
+	 * In FIFO mode sensor samples continuously, so \ref Scheduler::Event_t::PTSReady is posted right away.
+	 * 
+	 * @return \c Return_t::NOK on fail.
+	 * @return \c Return_t::OK on success. 
+	 */
+	Return_t start(void)
+	{
+		if (!oneShot)
 		{
-			_PRINT_ERROR("Filter config fail\n");
-			return Return_t::NOK;
+			Scheduler::post(Scheduler::Event_t::PTSReady);
+			return Return_t::OK;
 		}
 
-		static const ILPS22QS::DataOutputConfig_s dataOutputCfg = 
-		{
-			.dataRate = ILPS22QS::OutputDataRate_t::OneShot,
-			.average = ILPS22QS::Average_t::Average16
-		};
-		if (Sensor.setDataOutputConfig(dataOutputCfg) != ILPS22QS::Return_t::OK)
+		if (Sensor.measure() != ILPS22QS::Return_t::OK)
 		{
-			_PRINT_ERROR("Data output config fail\n");
+			sTPMSData.setErrorCode(Data::Error_t::MeasureFail);
+			_PRINT_ERROR("Measure start fail\n");
 			return Return_t::NOK;
 		}
 
+		// Sleep until conversion is done instead of polling data status over the bus
+		readRetries = 0;
+		Timer::start(Scheduler::Event_t::PTSReady, Sensor.getConversionTime(sensorCfg.dataOutput.average), 0);
+
 		return Return_t::OK;
 	}
 
 	/**
-	 * @brief Measure pressure and temperature.
+	 * @brief Read pressure and temperature measurement started with \ref start
 	 * 
 	 * @return \c Return_t::NOK on fail.
+	 * @return \c Return_t::Timeout if conversion is not done yet. \ref Scheduler::Event_t::PTSReady will be posted again.
 	 * @return \c Return_t::OK on success. 
 	 */
-	Return_t measure(void)
+	Return_t read(void)
 	{
-		if (Sensor.measure() != ILPS22QS::Return_t::OK)
+		if (AppConfig::ptsFIFO)
 		{
-			sTPMSData.setErrorCode(Data::Error_t::MeasureFail);
-			_PRINT_ERROR("Measure start fail\n");
-			return Return_t::NOK;
+			return readFIFO();
 		}
 
-		ILPS22QS::DataStatus_s status;
-		while (1)
+		// Output registers always hold latest sample when sensor samples continuously
+		if (oneShot)
 		{
+			ILPS22QS::DataStatus_s status;
 			if (Sensor.getDataStatus(status) != ILPS22QS::Return_t::OK)
 			{
 				sTPMSData.setErrorCode(Data::Error_t::MeasureStatus);
@@ -141,39 +211,55 @@ namespace PTS
 			}
 
 			// Wait for both measurments
-			if (status.pressureAvailable && status.temperatureAvailable)
+			if (!status.pressureAvailable || !status.temperatureAvailable)
 			{
-				uint8_t fail = 0;
-
-				if (Sensor.getPressure(pressure) != ILPS22QS::Return_t::OK)
-				{
-					_PRINT_ERROR("Pressure get fail\n");
-					fail = 1;
-				}
-				else
+				if (readRetries >= maxReadRetries)
 				{
-					_PRINTF_INFO("Pressure %umbar\n", getPressure());
+					sTPMSData.setErrorCode(Data::Error_t::MeasureStatus);
+					_PRINT_ERROR("Measure not ready\n");
+					return Return_t::NOK;
 				}
 
-				if (Sensor.getTemperature(temperature) != ILPS22QS::Return_t::OK)
-				{
-					_PRINT_ERROR("Temperature get fail\n");
-					fail = 1;
-				}
-				else
-				{
-					_PRINTF_INFO("Temperature %dcdegC\n", getTemperature());
-				}
-				
-				if (fail)
-				{
-					sTPMSData.setErrorCode(Data::Error_t::PartialData);
-				}
-
-				break;
+				readRetries++;
+				Timer::start(Scheduler::Event_t::PTSReady, retryDelay, 0);
+				return Return_t::Timeout;
 			}
 		}
 
+		// Read pressure and temperature in single bus transfer
+		ILPS22QS::Sample_s sample;
+		if (Sensor.getSample(sample) != ILPS22QS::Return_t::OK)
+		{
+			sTPMSData.setErrorCode(Data::Error_t::MeasureFail);
+			_PRINT_ERROR("Sample get fail\n");
+			return Return_t::NOK;
+		}
+
+		pressure = sample.pressure;
+		temperature = sample.temperature;
+		_PRINTF_INFO("Pressure %umbar\n", getPressure());
+		_PRINTF_INFO("Temperature %dcdegC\n", getTemperature());
+
+		return Return_t::OK;
+	}
+
+	/**
+	 * @brief Stop continuous sampling and put sensor to power-down mode.
+	 * 
+	 * @return \c Return_t::NOK on fail.
+	 * @return \c Return_t::OK on success.
+	 */
+	Return_t powerDown(void)
+	{
+		ILPS22QS::DataOutputConfig_s cfg = sensorCfg.dataOutput;
+		cfg.dataRate = ILPS22QS::OutputDataRate_t::OneShot;
+
+		if (Sensor.setDataOutputConfig(cfg) != ILPS22QS::Return_t::OK || TWI::wait() != Return_t::OK)
+		{
+			_PRINT_ERROR("Sensor power-down fail\n");
+			return Return_t::NOK;
+		}
+
 		return Return_t::OK;
 	}
 
@@ -200,6 +286,70 @@ namespace PTS
 
 
 // ----- STATIC FUNCTION DEFINITIONS
+/**
+ * @brief Drain sensor FIFO.
+ * 
+ * All collected pressure samples are added to history, newest sample and current temperature are used as measurement.
+ * 
+ * @return \c Return_t::NOK on fail.
+ * @return \c Return_t::OK on success. 
+ */
+static Return_t readFIFO(void)
+{
+	ILPS22QS::FIFOStatus_s status;
+	if (Sensor.getFIFOStatus(status) != ILPS22QS::Return_t::OK)
+	{
+		sTPMSData.setErrorCode(Data::Error_t::MeasureStatus);
+		_PRINT_ERROR("FIFO status fail\n");
+		return Return_t::NOK;
+	}
+
+	if (!status.level)
+	{
+		sTPMSData.setErrorCode(Data::Error_t::MeasureStatus);
+		_PRINT_ERROR("FIFO empty\n");
+		return Return_t::NOK;
+	}
+
+	if (status.overrun)
+	{
+		_PRINT_INFO("FIFO overrun\n");
+	}
+
+	// Drain FIFO in batches, oldest sample first
+	uint8_t level = status.level;
+	while (level)
+	{
+		const uint8_t count = (level > fifoBatch) ? fifoBatch : level;
+		if (Sensor.getFIFOData(fifoSamples, fifoRaw, count) != ILPS22QS::Return_t::OK)
+		{
+			sTPMSData.setErrorCode(Data::Error_t::MeasureFail);
+			_PRINT_ERROR("FIFO read fail\n");
+			return Return_t::NOK;
+		}
+
+		for (uint8_t i = 0; i < count; i++)
+		{
+			Data::addHistory(fifoSamples[i]);
+		}
+
+		level -= count;
+	}
+	pressure = fifoSamples[(status.level - 1) % fifoBatch];
+
+	if (Sensor.getTemperature(temperature) != ILPS22QS::Return_t::OK)
+	{
+		sTPMSData.setErrorCode(Data::Error_t::PartialData);
+		_PRINT_ERROR("Temperature get fail\n");
+	}
+
+	_PRINTF_INFO("FIFO %u samples\n", status.level);
+	_PRINTF_INFO("Pressure %umbar\n", pressure);
+	_PRINTF_INFO("Temperature %dcdegC\n", temperature);
+
+	return Return_t::OK;
+}
+
 /**
  * @brief TWI read handler for ILPS22QS.
  * 
@@ -211,64 +361,178 @@ namespace PTS
  * @return \c ILPS22QS::Return_t::NOK on fail.
  * @return \c ILPS22QS::Return_t::OK on success.
  */
-ILPS22QS::Return_t read(const uint8_t address, void* data, const uint8_t len, const uint8_t timeout)
+inline ILPS22QS::Return_t SensorBus::read(const uint8_t address, void* data, const uint8_t len, const uint8_t timeout)
+{
+	return writeRead(address, nullptr, 0, data, len, timeout);
+}
+
+/**
+ * @brief TWI write handler for ILPS22QS.
+ * 
+ * @param address TWI address of ILPS22QS.
+ * @param data Pointer to data to write.
+ * @param len Length of \c data
+ * @param timeout Operation timeout in ms.
+ * 
+ * @return \c ILPS22QS::Return_t::NOK on fail.
+ * @return \c ILPS22QS::Return_t::OK on success.
+ */
+inline ILPS22QS::Return_t SensorBus::write(const uint8_t address, void* data, const uint8_t len, const uint8_t timeout)
+{
+	return writeRead(address, data, len, nullptr, 0, timeout);
+}
+
+/**
+ * @brief TWI write-then-read handler for ILPS22QS.
+ * 
+ * Starts async transfer with repeated start condition and returns. Sensor semaphore is freed when transfer is done.
+ * With \c ILPS22QS_SYNC transfer is blocking.
+ * 
+ * @param address TWI address of ILPS22QS.
+ * @param txData Pointer to data to write.
+ * @param txLen Length of \c txData
+ * @param rxData Pointer to output buffer.
+ * @param rxLen Length of \c rxData
+ * @param timeout Operation timeout in ms.
+ * 
+ * @return \c ILPS22QS::Return_t::NOK on fail.
+ * @return \c ILPS22QS::Return_t::OK on success.
+ */
+inline ILPS22QS::Return_t SensorBus::writeRead(const uint8_t address, const void* txData, const uint8_t txLen, void* rxData, const uint8_t rxLen, const uint8_t timeout)
 {
 	(void)timeout;
-	
-	if (TWI::read(address, data, len) != Return_t::OK)
+
+	#ifdef ILPS22QS_SYNC
+	if (TWI::writeRead(address, txData, txLen, rxData, rxLen) != Return_t::OK)
 	{
 		return ILPS22QS::Return_t::NOK;
 	}
+	#else
+	Sensor.takeSemaphore();
+	if (TWI::transfer(address, txData, txLen, rxData, rxLen, onTransferDone) != Return_t::OK)
+	{
+		Sensor.freeSemaphore(ILPS22QS::Return_t::NOK);
+		return ILPS22QS::Return_t::NOK;
+	}
+	#endif // ILPS22QS_SYNC
 
 	return ILPS22QS::Return_t::OK;
 }
 
 /**
- * @brief TWI write handler for ILPS22QS.
+ * @brief TWI list handler for ILPS22QS.
+ * 
+ * Starts async list of writes and returns. Sensor semaphore is freed when all writes are done.
+ * With \c ILPS22QS_SYNC list is blocking.
  * 
  * @param address TWI address of ILPS22QS.
- * @param data Pointer to data to write.
- * @param len Length of \c data
+ * @param list Pointer to array of writes.
+ * @param entryLen Length of single write.
+ * @param count Number of writes.
  * @param timeout Operation timeout in ms.
  * 
  * @return \c ILPS22QS::Return_t::NOK on fail.
  * @return \c ILPS22QS::Return_t::OK on success.
  */
-ILPS22QS::Return_t write(const uint8_t address, void* data, const uint8_t len, const uint8_t timeout)
+inline ILPS22QS::Return_t SensorBus::writeList(const uint8_t address, const void* list, const uint8_t entryLen, const uint8_t count, const uint8_t timeout)
 {
 	(void)timeout;
 
-	if (TWI::write(address, data, len) != Return_t::OK)
+	#ifdef ILPS22QS_SYNC
+	if (TWI::transferList(address, list, entryLen, nullptr, 0, count, nullptr) != Return_t::OK || TWI::wait() != Return_t::OK)
+	{
+		return ILPS22QS::Return_t::NOK;
+	}
+	#else
+	Sensor.takeSemaphore();
+	if (TWI::transferList(address, list, entryLen, nullptr, 0, count, onTransferDone) != Return_t::OK)
 	{
+		Sensor.freeSemaphore(ILPS22QS::Return_t::NOK);
 		return ILPS22QS::Return_t::NOK;
 	}
+	#endif // ILPS22QS_SYNC
 
-	return ILPS22QS::Return_t::OK;	
+	return ILPS22QS::Return_t::OK;
 }
 
 /**
- * @brief ILPS22QS MSP init and deinit handler.
+ * @brief ILPS22QS MSP init handler.
  * 
  * @return \c ILPS22QS::Return_t::NOK on fail.
  * @return \c ILPS22QS::Return_t::OK on success.
  */
-ILPS22QS::Return_t msp(void)
+ILPS22QS::Return_t SensorBus::mspInit(void)
 {
 	_PRINT("ILPS22QS msp init\n");
 
-	nrf_gpio_cfg(NRF_GPIO_PIN_MAP(Hardware::ptsSelectPort, Hardware::ptsSelectPin),
-	NRF_GPIO_PIN_DIR_OUTPUT,
-	NRF_GPIO_PIN_INPUT_DISCONNECT,
-	NRF_GPIO_PIN_NOPULL,
-	NRF_GPIO_PIN_S0S1,
-	NRF_GPIO_PIN_NOSENSE);
+	// Select pin keeps ILPS22QS in TWI mode while sensor is in use, sensor is its single user
+	if (!selectHeld)
+	{
+		Power::acquire(Power::Domain_t::PTSSelect);
+		selectHeld = 1;
+	}
+
+	return ILPS22QS::Return_t::OK;
+}
+
+/**
+ * @brief ILPS22QS MSP deinit handler.
+ * 
+ * @return \c ILPS22QS::Return_t::NOK on fail.
+ * @return \c ILPS22QS::Return_t::OK on success.
+ */
+ILPS22QS::Return_t SensorBus::mspDeinit(void)
+{
+	// Keep ILPS22QS in TWI mode
+	return mspInit();
+}
+
+/**
+ * @brief ILPS22QS wait handler.
+ * 
+ * Sleeps until next interrupt, which is usually end of TWI transfer. Driver checks timeout after every wakeup.
+ * 
+ * @param period Wait period in ms. Not used.
+ * 
+ * @return No return value.
+ */
+inline void SensorBus::delay(const uint32_t period)
+{
+	(void)period;
 
-	// Set ILPS22QS in TWI mode
-	nrf_gpio_pin_write(NRF_GPIO_PIN_MAP(Hardware::ptsSelectPort, Hardware::ptsSelectPin), 1);
+	sd_app_evt_wait();
+}
+
+/**
+ * @brief ILPS22QS tick handler.
+ * 
+ * @param output Reference to tick output.
+ * 
+ * @return \c ILPS22QS::Return_t::OK
+ * 
+ * @note Timer tick is used as ms tick, so driver timeouts are about 2% shorter.
+ */
+inline ILPS22QS::Return_t SensorBus::getTick(uint32_t& output)
+{
+	output = Timer::getTick();
 
 	return ILPS22QS::Return_t::OK;
 }
 
+#ifndef ILPS22QS_SYNC
+/**
+ * @brief TWI transfer done callback.
+ * 
+ * @param status Transfer status.
+ * 
+ * @return No return value.
+ */
+static void onTransferDone(const Return_t status)
+{
+	Sensor.freeSemaphore((status == Return_t::OK) ? ILPS22QS::Return_t::OK : ILPS22QS::Return_t::NOK);
+}
+#endif // ILPS22QS_SYNC
+
 
 /** @} */
 
@@ -0,0 +1,289 @@
+/**
+ * @file Power.cpp
+ * @author silvio3105 (www.github.com/silvio3105)
+ * @brief Peripheral power domain module source file.
+ * 
+ * @copyright Copyright (c) 2025, silvio3105
+ * 
+ */
+
+/*
+	Copyright (c) 2025, silvio3105 (www.github.com/silvio3105)
+
+	Access and use of this Project and its contents are granted free of charge to any Person.
+	The Person is allowed to copy, modify and use The Project and its contents only for non-commercial use.
+	Commercial use of this Project and its contents is prohibited.
+	Modifying this License and/or sublicensing is prohibited.
+
+	THE PROJECT AND ITS CONTENT ARE PROVIDED "AS IS" WITH ALL FAULTS AND WITHOUT EXPRESSED OR IMPLIED WARRANTY.
+	THE AUTHOR KEEPS ALL RIGHTS TO CHANGE OR REMOVE THE CONTENTS OF THIS PROJECT WITHOUT PREVIOUS NOTICE.
+	THE AUTHOR IS NOT RESPONSIBLE FOR DAMAGE OF ANY KIND OR LIABILITY CAUSED BY USING THE CONTENTS OF THIS PROJECT.
+
+	This License shall be included in all functional textual files.
+*/
+
+// ----- INCLUDE FILES
+#include			"Power.hpp"
+#include			"Timer.hpp"
+
+#include			"nrf.h"
+#include			"nrf_gpio.h"
+#include			"nrf_twim.h"
+#include			"nrf_timer.h"
+#include			"nrf_saadc.h"
+#include			"app_util_platform.h"
+
+
+/**
+ * @addtogroup Power
+ * 
+ * Peripheral power domain module. Each domain is powered up by first \ref Power::acquire and stays powered while any user holds it.
+ * Last \ref Power::release only marks domain for power down, domains are powered down by \ref Power::flush before sleep.
+ * Domain released and acquired again in the same wakeup is not toggled.
+ * In debug build on time of each domain is accumulated and printed with \ref Power::report
+ * @{
+ */
+
+// ----- VARIABLES
+static uint8_t users[(uint8_t)Power::Domain_t::Count]; /**< @brief Number of users for each domain. */
+static uint8_t on = 0; /**< @brief Bitmap of powered domains. */
+
+#ifdef DEBUG
+static uint32_t onTick[(uint8_t)Power::Domain_t::Count]; /**< @brief Timer tick when domain was powered up. */
+static uint32_t onTicks[(uint8_t)Power::Domain_t::Count]; /**< @brief Timer ticks domain was powered since last report. */
+static uint16_t powerups[(uint8_t)Power::Domain_t::Count]; /**< @brief Number of domain power ups since last report. */
+#endif // DEBUG
+
+
+// ----- STATIC FUNCTION DECLARATIONS
+static void powerUp(const uint8_t domain);
+static void powerDown(const uint8_t domain);
+
+
+// ----- NAMESPACES
+/**
+ * @brief Peripheral power domain module namespace.
+ * 
+ */
+namespace Power
+{
+	// ----- FUNCTION DEFINITIONS
+	/**
+	 * @brief Acquire power domain.
+	 * 
+	 * Domain is powered up if it is not powered already.
+	 * 
+	 * @param domain Power domain. See \ref Domain_t
+	 * 
+	 * @return No return value.
+	 * 
+	 * @note Safe to call from interrupt handlers.
+	 */
+	void acquire(const Domain_t domain)
+	{
+		const uint8_t id = (uint8_t)domain;
+
+		CRITICAL_REGION_ENTER();
+
+		users[id]++;
+		if (!(on & (1 << id)))
+		{
+			powerUp(id);
+		}
+
+		CRITICAL_REGION_EXIT();
+	}
+
+	/**
+	 * @brief Release power domain.
+	 * 
+	 * Domain without users is powered down by next \ref flush
+	 * 
+	 * @param domain Power domain. See \ref Domain_t
+	 * 
+	 * @return No return value.
+	 * 
+	 * @note Safe to call from interrupt handlers.
+	 */
+	void release(const Domain_t domain)
+	{
+		const uint8_t id = (uint8_t)domain;
+
+		CRITICAL_REGION_ENTER();
+
+		if (users[id])
+		{
+			users[id]--;
+		}
+
+		CRITICAL_REGION_EXIT();
+	}
+
+	/**
+	 * @brief Power down all domains without users.
+	 * 
+	 * @return No return value.
+	 */
+	void flush(void)
+	{
+		CRITICAL_REGION_ENTER();
+
+		for (uint8_t i = 0; i < (uint8_t)Domain_t::Count; i++)
+		{
+			if ((on & (1 << i)) && !users[i])
+			{
+				powerDown(i);
+			}
+		}
+
+		CRITICAL_REGION_EXIT();
+	}
+
+	/**
+	 * @brief Check if power domain is powered.
+	 * 
+	 * @param domain Power domain. See \ref Domain_t
+	 * 
+	 * @return \c 1 if domain is powered, \c 0 otherwise.
+	 */
+	uint8_t isOn(const Domain_t domain)
+	{
+		return ((on >> (uint8_t)domain) & 1);
+	}
+
+	/**
+	 * @brief Print on time of each domain since last report.
+	 * 
+	 * @return No return value.
+	 * 
+	 * @note Report is available only in debug build.
+	 */
+	void report(void)
+	{
+		#ifdef DEBUG
+		const uint32_t tick = Timer::getTick();
+
+		for (uint8_t i = 0; i < (uint8_t)Domain_t::Count; i++)
+		{
+			// Count time of domains which are still powered up to now
+			if (on & (1 << i))
+			{
+				onTicks[i] += tick - onTick[i];
+				onTick[i] = tick;
+			}
+		}
+
+		_PRINTF_INFO("Power on ms: TWIM %lu(%u), SAADC %lu(%u), PTS select %lu(%u)\n",
+		(onTicks[0] * 1000) / Timer::tickRate, powerups[0],
+		(onTicks[1] * 1000) / Timer::tickRate, powerups[1],
+		(onTicks[2] * 1000) / Timer::tickRate, powerups[2]);
+
+		for (uint8_t i = 0; i < (uint8_t)Domain_t::Count; i++)
+		{
+			onTicks[i] = 0;
+			powerups[i] = 0;
+		}
+		#endif // DEBUG
+	}
+};
+
+
+// ----- STATIC FUNCTION DEFINITIONS
+/**
+ * @brief Power up domain.
+ * 
+ * @param domain Domain index. See \ref Power::Domain_t
+ * 
+ * @return No return value.
+ */
+static void powerUp(const uint8_t domain)
+{
+	switch ((Power::Domain_t)domain)
+	{
+		case Power::Domain_t::TWIM:
+		{
+			nrf_twim_enable(NRF_TWIM0);
+			break;
+		}
+
+		case Power::Domain_t::SAADC:
+		{
+			nrf_saadc_enable();
+			break;
+		}
+
+		case Power::Domain_t::PTSSelect:
+		{
+			nrf_gpio_cfg(NRF_GPIO_PIN_MAP(Hardware::ptsSelectPort, Hardware::ptsSelectPin),
+			NRF_GPIO_PIN_DIR_OUTPUT,
+			NRF_GPIO_PIN_INPUT_DISCONNECT,
+			NRF_GPIO_PIN_NOPULL,
+			NRF_GPIO_PIN_S0S1,
+			NRF_GPIO_PIN_NOSENSE);
+
+			// Set ILPS22QS in TWI mode
+			nrf_gpio_pin_write(NRF_GPIO_PIN_MAP(Hardware::ptsSelectPort, Hardware::ptsSelectPin), 1);
+			break;
+		}
+
+		default:
+		{
+			return;
+		}
+	}
+
+	on |= (1 << domain);
+
+	#ifdef DEBUG
+	onTick[domain] = Timer::getTick();
+	powerups[domain]++;
+	#endif // DEBUG
+}
+
+/**
+ * @brief Power down domain.
+ * 
+ * @param domain Domain index. See \ref Power::Domain_t
+ * 
+ * @return No return value.
+ */
+static void powerDown(const uint8_t domain)
+{
+	switch ((Power::Domain_t)domain)
+	{
+		case Power::Domain_t::TWIM:
+		{
+			nrf_twim_disable(NRF_TWIM0);
+			nrf_timer_task_trigger(NRF_TIMER1, NRF_TIMER_TASK_SHUTDOWN);
+			break;
+		}
+
+		case Power::Domain_t::SAADC:
+		{
+			nrf_saadc_disable();
+			break;
+		}
+
+		case Power::Domain_t::PTSSelect:
+		{
+			nrf_gpio_cfg_default(NRF_GPIO_PIN_MAP(Hardware::ptsSelectPort, Hardware::ptsSelectPin));
+			break;
+		}
+
+		default:
+		{
+			return;
+		}
+	}
+
+	on &= ~(1 << domain);
+
+	#ifdef DEBUG
+	onTicks[domain] += Timer::getTick() - onTick[domain];
+	#endif // DEBUG
+}
+
+
+/** @} */
+
+// END WITH NEW LINE
@@ -0,0 +1,243 @@
+/**
+ * @file Scheduler.cpp
+ * @author silvio3105 (www.github.com/silvio3105)
+ * @brief Event scheduler module source file.
+ * 
+ * @copyright Copyright (c) 2025, silvio3105
+ * 
+ */
+
+/*
+	Copyright (c) 2025, silvio3105 (www.github.com/silvio3105)
+
+	Access and use of this Project and its contents are granted free of charge to any Person.
+	The Person is allowed to copy, modify and use The Project and its contents only for non-commercial use.
+	Commercial use of this Project and its contents is prohibited.
+	Modifying this License and/or sublicensing is prohibited.
+
+	THE PROJECT AND ITS CONTENT ARE PROVIDED "AS IS" WITH ALL FAULTS AND WITHOUT EXPRESSED OR IMPLIED WARRANTY.
+	THE AUTHOR KEEPS ALL RIGHTS TO CHANGE OR REMOVE THE CONTENTS OF THIS PROJECT WITHOUT PREVIOUS NOTICE.
+	THE AUTHOR IS NOT RESPONSIBLE FOR DAMAGE OF ANY KIND OR LIABILITY CAUSED BY USING THE CONTENTS OF THIS PROJECT.
+
+	This License shall be included in all functional textual files.
+*/
+
+// ----- INCLUDE FILES
+#include			"Scheduler.hpp"
+#include			"System.hpp"
+
+#include			"nrf.h"
+#include			"nrf_atomic.h"
+
+#include			<string.h>
+
+
+/**
+ * @addtogroup Scheduler
+ * 
+ * Cooperative event scheduler. Interrupts post events, tasks subscribed to events run to completion in thread mode.
+ * Device sleeps in \c sd_app_evt_wait() whenever there is no pending event.
+ * Wakeups which do not post any event, like SoftDevice radio and advertise events, go straight back to sleep.
+ * @{
+ */
+
+// ----- VARIABLES
+static nrf_atomic_u32_t pending = 0; /**< @brief Bitmap of pending events. */
+static Scheduler::Task_f tasks[(uint8_t)Scheduler::Event_t::Count]; /**< @brief Task handler for each event. */
+
+#ifdef DEBUG
+static uint32_t activeCycles = 0; /**< @brief CPU cycles spent out of sleep since last report. */
+static uint32_t wakeupCount = 0; /**< @brief Number of wakeups since last report. */
+static uint32_t sdWakeupCount = 0; /**< @brief Number of wakeups without pending event since last report. */
+static uint32_t wakeSource[(uint8_t)Scheduler::Event_t::Count]; /**< @brief Number of wakeups ended by each event since last report. */
+static uint32_t activeStart = 0; /**< @brief Cycle counter value at last wakeup. */
+#endif // DEBUG
+
+
+// ----- STATIC FUNCTION DECLARATIONS
+static inline void profileStart(void);
+static inline void profileStop(void);
+
+
+// ----- NAMESPACES
+/**
+ * @brief Scheduler module namespace.
+ * 
+ */
+namespace Scheduler
+{
+	// ----- FUNCTION DEFINITIONS
+	/**
+	 * @brief Init scheduler.
+	 * 
+	 * @return No return value.
+	 */
+	void init(void)
+	{
+		pending = 0;
+		memset(tasks, 0, sizeof(tasks));
+
+		// Enable DWT cycle counter for active time report
+		#ifdef DEBUG
+		CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+		DWT->CYCCNT = 0;
+		DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+		profileStart();
+		#endif // DEBUG
+	}
+
+	/**
+	 * @brief Subscribe task to event.
+	 * 
+	 * @param event Event to subscribe to. See \ref Event_t
+	 * @param task Pointer to task handler. Set to \c nullptr to unsubscribe.
+	 * 
+	 * @return No return value.
+	 */
+	void subscribe(const Event_t event, const Task_f task)
+	{
+		tasks[(uint8_t)event] = task;
+	}
+
+	/**
+	 * @brief Post event.
+	 * 
+	 * @param event Event to post. See \ref Event_t
+	 * 
+	 * @return No return value.
+	 * 
+	 * @note Safe to call from interrupt handlers.
+	 */
+	void post(const Event_t event)
+	{
+		nrf_atomic_u32_or(&pending, (1 << (uint8_t)event));
+	}
+
+	/**
+	 * @brief Run tasks for all pending events.
+	 * 
+	 * @return \c Return_t::NOK if there were no pending events.
+	 * @return \c Return_t::OK if at least one task was run.
+	 */
+	Return_t run(void)
+	{
+		uint32_t events = nrf_atomic_u32_fetch_store(&pending, 0);
+		if (!events)
+		{
+			return Return_t::NOK;
+		}
+
+		for (uint8_t i = 0; i < (uint8_t)Event_t::Count; i++)
+		{
+			if ((events & (1 << i)) && tasks[i])
+			{
+				tasks[i]();
+			}
+		}
+
+		return Return_t::OK;
+	}
+
+	/**
+	 * @brief Put device to sleep until next event.
+	 * 
+	 * @return No return value.
+	 */
+	void idle(void)
+	{
+		profileStop();
+
+		while (!pending)
+		{
+			System::sleep();
+
+			#ifdef DEBUG
+			wakeupCount++;
+
+			// Events pending right after wakeup are ones which ended the sleep
+			const uint32_t events = pending;
+			if (!events)
+			{
+				sdWakeupCount++;
+			}
+
+			for (uint8_t i = 0; i < (uint8_t)Event_t::Count; i++)
+			{
+				if (events & (1 << i))
+				{
+					wakeSource[i]++;
+				}
+			}
+			#endif // DEBUG
+		}
+
+		profileStart();
+	}
+
+	/**
+	 * @brief Print active CPU time and wake sources since last report.
+	 * 
+	 * Wake source is event which ended the sleep or SoftDevice if wakeup posted no event.
+	 * Timers which share wakeup are all counted as its source.
+	 * 
+	 * @return No return value.
+	 * 
+	 * @note Report is available only in debug build.
+	 */
+	void report(void)
+	{
+		#ifdef DEBUG
+		profileStop();
+
+		const uint32_t activeUs = activeCycles / (SystemCoreClock / 1000000);
+		_PRINTF_INFO("Active %luus in %lu wakeups (%luus/wakeup, %lu without event)\n", activeUs, wakeupCount, wakeupCount ? activeUs / wakeupCount : 0, sdWakeupCount);
+
+		_PRINTF_INFO("Wake sources: SoftDevice %lu", sdWakeupCount);
+		for (uint8_t i = 0; i < (uint8_t)Event_t::Count; i++)
+		{
+			if (wakeSource[i])
+			{
+				_PRINTF_INFO(", event %u %lu", i, wakeSource[i]);
+			}
+		}
+		_PRINT_INFO("\n");
+
+		activeCycles = 0;
+		wakeupCount = 0;
+		sdWakeupCount = 0;
+		memset(wakeSource, 0, sizeof(wakeSource));
+		profileStart();
+		#endif // DEBUG
+	}
+};
+
+
+// ----- STATIC FUNCTION DEFINITIONS
+/**
+ * @brief Mark start of active CPU time.
+ * 
+ * @return No return value.
+ */
+static inline void profileStart(void)
+{
+	#ifdef DEBUG
+	activeStart = DWT->CYCCNT;
+	#endif // DEBUG
+}
+
+/**
+ * @brief Mark end of active CPU time.
+ * 
+ * @return No return value.
+ */
+static inline void profileStop(void)
+{
+	#ifdef DEBUG
+	activeCycles += DWT->CYCCNT - activeStart;
+	#endif // DEBUG
+}
+
+
+/** @} */
+
+// END WITH NEW LINE
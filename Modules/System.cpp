@@ -11,12 +11,12 @@
 #include			"System.hpp"
 #include			"Data.hpp"
 #include			"BLE.hpp"
-#include			"TWI.hpp"
+#include			"Power.hpp"
 
 #include			"nrf.h"
 #include			"nrf_clock.h"
 #include			"nrf_power.h"
-#include			"nrf_rtc.h"
+#include			"nrf_gpio.h"
 #include			"nrf_nvic.h"
 #include 			"app_error.h"
 #include 			"nrf_soc.h"
@@ -26,17 +26,18 @@
 /**
  * @addtogroup System
  * 
- * System module. Configures clocks, power, watchdog and \c RTC2 for wakeup.
+ * System module. Configures clocks, power and watchdog.
  * @{
  */
 
 // ----- VARIABLES
-static volatile uint8_t wakeup = 0; /**< @brief Flag for RTC2 wakeup event. */
 static System::Reset_t resetReason = System::Reset_t::Unknown; /**< @brief Reset reason. */
+static constexpr uint8_t ramBlock = (MemoryMap::sramEEPROMStart - 0x20000000) / 0x2000; /**< @brief RAM block with SRAM EEPROM. */
+static constexpr uint8_t ramSection = ((MemoryMap::sramEEPROMStart - 0x20000000) % 0x2000) / 0x1000; /**< @brief RAM block section with SRAM EEPROM. */
+static_assert((MemoryMap::sramEEPROMStart % 0x1000) + MemoryMap::sramEEPROMSize <= 0x1000, "SRAM EEPROM must be in single RAM section");
 
 
 // ----- STATIC FUNCTION DECLARATIONS
-static inline void stopWakeupTimer(void);
 static inline void testXTAL(void);
 static inline void setResetReason(void);
 static inline void powerInit(void);
@@ -67,76 +68,57 @@ namespace System
 		powerInit();
 		watchdogInit();
 
-		// Enable RTC interrupt
-		ret_code_t ret = sd_nvic_SetPriority(RTC2_IRQn, 2);
-		if (ret != NRF_SUCCESS)
-		{
-			APP_ERROR_CHECK(ret);
-			return Return_t::NOK;
-		}
-
-		ret = sd_nvic_EnableIRQ(RTC2_IRQn);
-		if (ret != NRF_SUCCESS)
-		{
-			APP_ERROR_CHECK(ret);
-			return Return_t::NOK;
-		}
-
-		nrf_rtc_int_enable(NRF_RTC2, NRF_RTC_INT_COMPARE0_MASK);
-		nrf_rtc_prescaler_set(NRF_RTC2, 4095); // 125ms resolution
-
 		return Return_t::OK;
 	}
 
 	/**
-	 * @brief Start RTC2 wakeup timer.
+	 * @brief Put device to sleep.
 	 * 
 	 * @return No return value.
 	 */
-	void startWakeupTimer(const uint8_t period)
+	void sleep(void)
 	{
-		nrf_rtc_task_trigger(NRF_RTC2, NRF_RTC_TASK_CLEAR);
-		nrf_rtc_cc_set(NRF_RTC2, 0, ((period * 1000) / 125));
-		nrf_rtc_task_trigger(NRF_RTC2, NRF_RTC_TASK_START);
+		__set_FPSCR(__get_FPSCR()  & ~(0x0000009F));      
+		(void) __get_FPSCR();
+		sd_nvic_ClearPendingIRQ(FPU_IRQn);		
 
-		_PRINT_INFO("Wakeup timer started\n");
-	}
+		// Peripherals are powered up again by task which needs them
+		Power::flush();
 
-	/**
-	 * @brief Is device woken up by RTC2 timer?
-	 * 
-	 * @return \c Return_t::NOK not woken up by RTC.
-	 * @return \c Return_t::OK woken up by RTC.
-	 */
-	Return_t isWoken(void)
-	{
-		if (wakeup)
-		{
-			wakeup = 0;
-			return Return_t::OK;
-		}
-
-		return Return_t::NOK;
+		_PRINT("Sleep\n");
+		sd_app_evt_wait();
+		_PRINT("Sleep done\n");
 	}
 
 	/**
-	 * @brief Put device to sleep.
+	 * @brief Put device to System OFF.
+	 * 
+	 * SRAM EEPROM stays retained and device resets with \ref Reset_t::SystemOff on wakeup.
+	 * Device is woken by wake GPIO if board has it, otherwise only by reset pin.
 	 * 
 	 * @return No return value.
+	 * 
+	 * @note Function does not return. In debug interface mode System OFF is emulated and watchdog resets the device.
 	 */
-	void sleep(void)
+	void off(void)
 	{
-		__set_FPSCR(__get_FPSCR()  & ~(0x0000009F));      
-		(void) __get_FPSCR();
-		sd_nvic_ClearPendingIRQ(FPU_IRQn);		
+		Data::eeprom->rstReason = Reset_t::SystemOff;
 
-		TWI::deinit();
+		// Retain RAM section with SRAM EEPROM
+		sd_power_ram_power_set(ramBlock, (POWER_RAM_POWER_S0RETENTION_Msk << ramSection));
 
-		_PRINT("Sleep\n");
-		sd_app_evt_wait();
-		_PRINT("Sleep done\n");
+		Power::flush();
 
-		TWI::init();
+		if (Hardware::wakeLine)
+		{
+			nrf_gpio_cfg_sense_input(NRF_GPIO_PIN_MAP(Hardware::wakePort, Hardware::wakePin), NRF_GPIO_PIN_PULLUP, NRF_GPIO_PIN_SENSE_LOW);
+		}
+
+		_PRINT_INFO("System OFF\n");
+		while (1)
+		{
+			sd_power_system_off();
+		}
 	}
 
 	/**
@@ -173,16 +155,6 @@ namespace System
 
 
 // ----- STATIC FUNCTION DEFINITIONS
-/**
- * @brief Stop wakeup timer.
- * 
- * @return No return value.
- */
-static inline void stopWakeupTimer(void)
-{
-	nrf_rtc_task_trigger(NRF_RTC2, NRF_RTC_TASK_STOP);
-}
-
 /**
  * @brief Test external crystals.
  * 
@@ -199,6 +171,7 @@ static inline void testXTAL(void)
 
 	while (!nrf_clock_event_check(NRF_CLOCK_EVENT_HFCLKSTARTED));
 
+	// Stop HFXO before SoftDevice takes over the clock
 	nrf_clock_event_clear(NRF_CLOCK_EVENT_HFCLKSTARTED);
 	nrf_clock_task_trigger(NRF_CLOCK_TASK_HFCLKSTOP);
 	_PRINT("HFXO works\n");
@@ -309,27 +282,6 @@ static inline void watchdogInit(void)
 // ----- INTERRUPTS
 extern "C"
 {
-	/**
-	 * @brief RTC2 interrupt handler.
-	 * 
-	 * @return No return value.
-	 */
-	void RTC2_IRQHandler(void)
-	{
-		_PRINT("RTC2 IRQ\n");
-		sd_nvic_ClearPendingIRQ(RTC2_IRQn);
-
-		if (nrf_rtc_event_pending(NRF_RTC2, NRF_RTC_EVENT_COMPARE_0))
-		{
-			nrf_rtc_event_clear(NRF_RTC2, NRF_RTC_EVENT_COMPARE_0);
-			stopWakeupTimer();
-
-			wakeup = 1;
-			_PRINT_INFO("Wakeup\n");
-			
-		}
-	}
-
 	void NMI_Handler(void)
 	{
 		_PRINT_ERROR("NMI\n");
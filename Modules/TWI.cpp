@@ -24,27 +24,45 @@
 
 // ----- INCLUDE FILES
 #include			"TWI.hpp"
+#include			"Power.hpp"
 
 #include			"nrf.h"
 #include			"nrf_gpio.h"
 #include 			"nrf_twim.h"
+#include			"nrf_timer.h"
 #include			"nrf_nvic.h"
+#include			"nrf_soc.h"
 #include			"app_error.h"
 
 
 /**
  * @addtogroup TWI 
  * 
- * \c TWI0 module with basic functions.
+ * \c TWI0 module with EasyDMA transfers. Transfers are started with \ref TWI::transfer and completed in \c TWI0 interrupt,
+ * blocking functions sleep in \c sd_app_evt_wait() until transfer is done.
+ * Each transfer holds \ref Power::Domain_t::TWIM until it is done, interrupts and \c PPI stay configured while \c TWIM is powered down.
+ * 
+ * \ref TWI::transferList runs list of fixed size transactions back-to-back using EasyDMA array list.
+ * Each \c STOPPED event restarts TWIM and is counted by \c TIMER1 over PPI. \c TIMER1 disables restart after second to last transaction
+ * and ends the job with interrupt after the last one.
  * @{
  */
 
 // ----- STATIC FUNCTION DECLARATIONS
-static Return_t isErrorActive(void);
-
+static void finish(void);
 
 // ----- VARIABLES
-static volatile uint8_t error = 0; /**< @brief TWI bus error flag. */
+static volatile uint8_t busy = 0; /**< @brief Transfer in progress flag. */
+static volatile uint8_t error = 0; /**< @brief TWI bus error flag for ongoing transfer. */
+static volatile Return_t status = Return_t::OK; /**< @brief Status of last finished transfer. */
+static TWI::Callback_f doneCallback = nullptr; /**< @brief Callback for ongoing transfer. */
+static volatile uint8_t listActive = 0; /**< @brief List job in progress flag. */
+static uint16_t transferCount = 0; /**< @brief Number of bus transfers since last clear. */
+
+static constexpr uint8_t listRestartPPI = 0; /**< @brief PPI channel for \c STOPPED -> \c STARTTX */
+static constexpr uint8_t listCountPPI = 1; /**< @brief PPI channel for \c STOPPED -> \c TIMER1 count. */
+static constexpr uint8_t listEndPPI = 2; /**< @brief PPI channel for \c TIMER1 \c COMPARE0 -> restart channel group disable. */
+static constexpr uint8_t listPPIGroup = 0; /**< @brief PPI channel group with \ref listRestartPPI */
 
 
 // ----- NAMESPACES
@@ -64,7 +82,7 @@ namespace TWI
 	Return_t init(void)
 	{
 		// Enable interrupts
-		nrf_twim_int_enable(NRF_TWIM0, NRF_TWIM_INT_ERROR_MASK);
+		nrf_twim_int_enable(NRF_TWIM0, NRF_TWIM_INT_ERROR_MASK | NRF_TWIM_INT_STOPPED_MASK);
 		ret_code_t ret = sd_nvic_SetPriority(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn, 3);
 		if (ret != NRF_SUCCESS)
 		{
@@ -79,19 +97,54 @@ namespace TWI
 			return Return_t::NOK;
 		}
 
-		// Set TWI speed to 100kHz
-		nrf_twim_frequency_set(NRF_TWIM0, NRF_TWIM_FREQ_400K);
+		// Set TIMER1 to count list transactions
+		nrf_timer_task_trigger(NRF_TIMER1, NRF_TIMER_TASK_STOP);
+		nrf_timer_mode_set(NRF_TIMER1, NRF_TIMER_MODE_COUNTER);
+		nrf_timer_bit_width_set(NRF_TIMER1, NRF_TIMER_BIT_WIDTH_16);
+		nrf_timer_int_enable(NRF_TIMER1, NRF_TIMER_INT_COMPARE1_MASK);
+
+		ret = sd_nvic_SetPriority(TIMER1_IRQn, 3);
+		if (ret != NRF_SUCCESS)
+		{
+			APP_ERROR_CHECK(ret);
+			return Return_t::NOK;
+		}
+
+		ret = sd_nvic_EnableIRQ(TIMER1_IRQn);
+		if (ret != NRF_SUCCESS)
+		{
+			APP_ERROR_CHECK(ret);
+			return Return_t::NOK;
+		}
 
-		nrf_twim_int_enable(NRF_TWIM0, NRF_TWIM_INT_ERROR_MASK);
+		// Chain list transactions over PPI. Count and end channels are harmless while TIMER1 is stopped
+		ret = sd_ppi_channel_assign(listRestartPPI, nrf_twim_event_address_get(NRF_TWIM0, NRF_TWIM_EVENT_STOPPED), nrf_twim_task_address_get(NRF_TWIM0, NRF_TWIM_TASK_STARTTX));
+		ret |= sd_ppi_channel_assign(listCountPPI, nrf_twim_event_address_get(NRF_TWIM0, NRF_TWIM_EVENT_STOPPED), nrf_timer_task_address_get(NRF_TIMER1, NRF_TIMER_TASK_COUNT));
+		ret |= sd_ppi_channel_assign(listEndPPI, nrf_timer_event_address_get(NRF_TIMER1, NRF_TIMER_EVENT_COMPARE0), &NRF_PPI->TASKS_CHG[listPPIGroup].DIS);
+		ret |= sd_ppi_group_assign(listPPIGroup, (1 << listRestartPPI));
+		ret |= sd_ppi_group_task_disable(listPPIGroup);
+		ret |= sd_ppi_channel_enable_set((1 << listCountPPI) | (1 << listEndPPI));
+		if (ret != NRF_SUCCESS)
+		{
+			APP_ERROR_CHECK(ret);
+			return Return_t::NOK;
+		}
+
+		// Set TWI speed to 400kHz
+		nrf_twim_frequency_set(NRF_TWIM0, NRF_TWIM_FREQ_400K);
 
 		// Set TWI pins
 		nrf_twim_pins_set(NRF_TWIM0, Hardware::ptsSCLPin, Hardware::ptsSDAPin);
 
-		// Clear TWI errors
+		// Clear TWI errors and events
 		nrf_twim_errorsrc_get_and_clear(NRF_TWIM0);
+		nrf_twim_event_clear(NRF_TWIM0, NRF_TWIM_EVENT_STOPPED);
+		nrf_twim_event_clear(NRF_TWIM0, NRF_TWIM_EVENT_ERROR);
+		busy = 0;
+		listActive = 0;
 
-		// Enable TWI bus
-		nrf_twim_enable(NRF_TWIM0);
+		// TWI bus is powered up by first transfer
+		nrf_twim_disable(NRF_TWIM0);
 
 		return Return_t::OK;
 	}
@@ -111,16 +164,179 @@ namespace TWI
 			return Return_t::NOK;
 		}
 
-		nrf_twim_int_disable(NRF_TWIM0, NRF_TWIM_INT_ERROR_MASK);
+		ret = sd_nvic_DisableIRQ(TIMER1_IRQn);
+		if (ret != NRF_SUCCESS)
+		{
+			APP_ERROR_CHECK(ret);
+			return Return_t::NOK;
+		}
+
+		nrf_twim_int_disable(NRF_TWIM0, NRF_TWIM_INT_ERROR_MASK | NRF_TWIM_INT_STOPPED_MASK);
 		nrf_twim_task_trigger(NRF_TWIM0, NRF_TWIM_TASK_STOP);
-		nrf_twim_disable(NRF_TWIM0);
 
-		nrf_gpio_cfg_default(NRF_GPIO_PIN_MAP(Hardware::ptsSCLPort, Hardware::ptsSDAPin));
+		// Aborted transfer never finishes, so drop its power domain user here
+		if (busy)
+		{
+			busy = 0;
+			listActive = 0;
+			Power::release(Power::Domain_t::TWIM);
+		}
+
+		// TWIM and TIMER1 are powered down through power module so its state stays valid
+		Power::flush();
+
+		nrf_gpio_cfg_default(NRF_GPIO_PIN_MAP(Hardware::ptsSCLPort, Hardware::ptsSCLPin));
 		nrf_gpio_cfg_default(NRF_GPIO_PIN_MAP(Hardware::ptsSDAPort, Hardware::ptsSDAPin));
 
 		return Return_t::OK;
 	}
 
+	/**
+	 * @brief Start TWI transfer.
+	 * 
+	 * If both \c txLen and \c rxLen are set, \c txData is written and \c rxLen bytes are read after repeated start condition.
+	 * Transfer is always ended with stop condition. Function returns as soon as EasyDMA transfer is started.
+	 * 
+	 * @param address Address of a slave on TWI bus.
+	 * @param txData Pointer to data to write. Must be in RAM.
+	 * @param txLen Length of \c txData Set to \c 0 for read only transfer.
+	 * @param rxData Pointer to output buffer. Must be in RAM.
+	 * @param rxLen Number of bytes to read. Set to \c 0 for write only transfer.
+	 * @param callback Pointer to function called when transfer is done. Optional.
+	 * 
+	 * @return \c Return_t::NOK if transfer is already in progress or there is nothing to transfer.
+	 * @return \c Return_t::OK if transfer is started.
+	 */
+	Return_t transfer(const uint8_t address, const void* txData, const uint16_t txLen, void* rxData, const uint16_t rxLen, const Callback_f callback)
+	{
+		if (busy || (!txLen && !rxLen))
+		{
+			return Return_t::NOK;
+		}
+
+		busy = 1;
+		error = 0;
+		doneCallback = callback;
+		transferCount++;
+		Power::acquire(Power::Domain_t::TWIM);
+
+		nrf_twim_address_set(NRF_TWIM0, address);
+		nrf_twim_event_clear(NRF_TWIM0, NRF_TWIM_EVENT_STOPPED);
+
+		if (txLen)
+		{
+			nrf_twim_tx_buffer_set(NRF_TWIM0, (const uint8_t*)txData, txLen);
+
+			if (rxLen)
+			{
+				// Write, repeated start, read, stop
+				nrf_twim_rx_buffer_set(NRF_TWIM0, (uint8_t*)rxData, rxLen);
+				nrf_twim_shorts_set(NRF_TWIM0, NRF_TWIM_SHORT_LASTTX_STARTRX_MASK | NRF_TWIM_SHORT_LASTRX_STOP_MASK);
+			}
+			else
+			{
+				nrf_twim_shorts_set(NRF_TWIM0, NRF_TWIM_SHORT_LASTTX_STOP_MASK);
+			}
+
+			nrf_twim_task_trigger(NRF_TWIM0, NRF_TWIM_TASK_STARTTX);
+		}
+		else
+		{
+			nrf_twim_rx_buffer_set(NRF_TWIM0, (uint8_t*)rxData, rxLen);
+			nrf_twim_shorts_set(NRF_TWIM0, NRF_TWIM_SHORT_LASTRX_STOP_MASK);
+			nrf_twim_task_trigger(NRF_TWIM0, NRF_TWIM_TASK_STARTRX);
+		}
+
+		return Return_t::OK;
+	}
+
+	/**
+	 * @brief Start list of TWI transfers.
+	 * 
+	 * Runs \c count transactions to the same slave without CPU between them. Transaction \c n writes \c txLen bytes from \c txList + \c n * \c txLen
+	 * and, if \c rxLen is set, reads \c rxLen bytes to \c rxList + \c n * \c rxLen after repeated start condition.
+	 * Function returns as soon as first transaction is started.
+	 * 
+	 * @param address Address of a slave on TWI bus.
+	 * @param txList Pointer to array of transactions to write. Must be in RAM.
+	 * @param txLen Length of single write transaction.
+	 * @param rxList Pointer to output array. Must be in RAM.
+	 * @param rxLen Length of single read transaction. Set to \c 0 for write only transactions.
+	 * @param count Number of transactions.
+	 * @param callback Pointer to function called when all transactions are done. Optional.
+	 * 
+	 * @return \c Return_t::NOK if transfer is already in progress or there is nothing to transfer.
+	 * @return \c Return_t::OK if list is started.
+	 * 
+	 * @note Transfer error does not stop the list. Remaining transactions are attempted and whole job ends with error status.
+	 */
+	Return_t transferList(const uint8_t address, const void* txList, const uint8_t txLen, void* rxList, const uint8_t rxLen, const uint8_t count, const Callback_f callback)
+	{
+		if (busy || !txLen || !count)
+		{
+			return Return_t::NOK;
+		}
+
+		busy = 1;
+		error = 0;
+		listActive = 1;
+		doneCallback = callback;
+		transferCount++;
+		Power::acquire(Power::Domain_t::TWIM);
+
+		// TIMER1 disables restart channel after second to last and ends job after last transaction
+		nrf_timer_task_trigger(NRF_TIMER1, NRF_TIMER_TASK_CLEAR);
+		nrf_timer_event_clear(NRF_TIMER1, NRF_TIMER_EVENT_COMPARE0);
+		nrf_timer_event_clear(NRF_TIMER1, NRF_TIMER_EVENT_COMPARE1);
+		nrf_timer_cc_write(NRF_TIMER1, NRF_TIMER_CC_CHANNEL0, count - 1);
+		nrf_timer_cc_write(NRF_TIMER1, NRF_TIMER_CC_CHANNEL1, count);
+		nrf_timer_task_trigger(NRF_TIMER1, NRF_TIMER_TASK_START);
+
+		if (count > 1)
+		{
+			sd_ppi_group_task_enable(listPPIGroup);
+		}
+
+		// Job is finished by TIMER1, not by each STOPPED event
+		nrf_twim_int_disable(NRF_TWIM0, NRF_TWIM_INT_STOPPED_MASK);
+		nrf_twim_address_set(NRF_TWIM0, address);
+		nrf_twim_event_clear(NRF_TWIM0, NRF_TWIM_EVENT_STOPPED);
+
+		nrf_twim_tx_buffer_set(NRF_TWIM0, (const uint8_t*)txList, txLen);
+		nrf_twim_tx_list_enable(NRF_TWIM0);
+
+		if (rxLen)
+		{
+			nrf_twim_rx_buffer_set(NRF_TWIM0, (uint8_t*)rxList, rxLen);
+			nrf_twim_rx_list_enable(NRF_TWIM0);
+			nrf_twim_shorts_set(NRF_TWIM0, NRF_TWIM_SHORT_LASTTX_STARTRX_MASK | NRF_TWIM_SHORT_LASTRX_STOP_MASK);
+		}
+		else
+		{
+			nrf_twim_shorts_set(NRF_TWIM0, NRF_TWIM_SHORT_LASTTX_STOP_MASK);
+		}
+
+		nrf_twim_task_trigger(NRF_TWIM0, NRF_TWIM_TASK_STARTTX);
+
+		return Return_t::OK;
+	}
+
+	/**
+	 * @brief Sleep until ongoing transfer is done.
+	 * 
+	 * @return \c Return_t::NOK if last transfer failed.
+	 * @return \c Return_t::OK if last transfer was successful.
+	 */
+	Return_t wait(void)
+	{
+		while (busy)
+		{
+			sd_app_evt_wait();
+		}
+
+		return status;
+	}
+
 	/**
 	 * @brief Write to TWI bus.
 	 * 
@@ -133,21 +349,12 @@ namespace TWI
 	 */
 	Return_t write(const uint8_t address, const void* data, const uint16_t len)
 	{
-		nrf_twim_address_set(NRF_TWIM0, address);
-		nrf_twim_tx_buffer_set(NRF_TWIM0, (const uint8_t*)data, len);
-		nrf_twim_task_trigger(NRF_TWIM0, NRF_TWIM_TASK_STARTTX);
-
-		while (!nrf_twim_event_check(NRF_TWIM0, NRF_TWIM_EVENT_LASTTX))
+		if (transfer(address, data, len, nullptr, 0, nullptr) != Return_t::OK)
 		{
-			if (isErrorActive() == Return_t::OK)
-			{
-				nrf_twim_task_trigger(NRF_TWIM0, NRF_TWIM_TASK_STOP);
-				return Return_t::NOK;
-			}
+			return Return_t::NOK;
 		}
 
-		nrf_twim_event_clear(NRF_TWIM0, NRF_TWIM_EVENT_LASTTX);		
-		return Return_t::OK;
+		return wait();
 	}
 
 	/**
@@ -162,42 +369,79 @@ namespace TWI
 	 */
 	Return_t read(const uint8_t address, void* output, const uint16_t len)
 	{
-		nrf_twim_address_set(NRF_TWIM0, address);
-		nrf_twim_rx_buffer_set(NRF_TWIM0, (uint8_t*)output, len);
-		nrf_twim_shorts_enable(NRF_TWIM0, NRF_TWIM_SHORT_LASTRX_STOP_MASK);
-		nrf_twim_task_trigger(NRF_TWIM0, NRF_TWIM_TASK_STARTRX);
+		if (transfer(address, nullptr, 0, output, len, nullptr) != Return_t::OK)
+		{
+			return Return_t::NOK;
+		}
 
-		while (!nrf_twim_event_check(NRF_TWIM0, NRF_TWIM_EVENT_STOPPED))
+		return wait();
+	}
+
+	/**
+	 * @brief Write to and then read from TWI bus with repeated start condition.
+	 * 
+	 * @param address Address of a slave on TWI bus.
+	 * @param txData Pointer to data to write.
+	 * @param txLen Length of \c txData
+	 * @param rxData Pointer to output.
+	 * @param rxLen Number of bytes to read.
+	 * 
+	 * @return \c Return_t::NOK on fail.
+	 * @return \c Return_t::OK on success.
+	 */
+	Return_t writeRead(const uint8_t address, const void* txData, const uint16_t txLen, void* rxData, const uint16_t rxLen)
+	{
+		if (transfer(address, txData, txLen, rxData, rxLen, nullptr) != Return_t::OK)
 		{
-			if (isErrorActive() == Return_t::OK)
-			{
-				nrf_twim_task_trigger(NRF_TWIM0, NRF_TWIM_TASK_STOP);
-				return Return_t::NOK;
-			}
+			return Return_t::NOK;
 		}
 
-		nrf_twim_event_clear(NRF_TWIM0, NRF_TWIM_EVENT_STOPPED);
-		return Return_t::OK;
+		return wait();
+	}
+
+	/**
+	 * @brief Get number of bus transfers.
+	 * 
+	 * @return Number of bus transfers since last \ref clearTransferCount call.
+	 */
+	uint16_t getTransferCount(void)
+	{
+		return transferCount;
+	}
+
+	/**
+	 * @brief Clear bus transfer counter.
+	 * 
+	 * @return No return value.
+	 */
+	void clearTransferCount(void)
+	{
+		transferCount = 0;
 	}
 };
 
 
 // ----- STATIC FUNCTION DEFINITIONS
 /**
- * @brief Check is TWI bus error active.
+ * @brief Finish ongoing transfer or list job.
+ * 
+ * @return No return value.
  * 
- * @return \c Return_t::NOK no error on TWI bus.
- * @return \c Return_t::OK error on TWI bus. 
+ * @note Called from interrupt.
  */
-static Return_t isErrorActive(void)
+static void finish(void)
 {
-	if (error)
+	nrf_twim_event_clear(NRF_TWIM0, NRF_TWIM_EVENT_STOPPED);
+	nrf_twim_shorts_set(NRF_TWIM0, 0);
+
+	status = error ? Return_t::NOK : Return_t::OK;
+	busy = 0;
+	Power::release(Power::Domain_t::TWIM);
+
+	if (doneCallback)
 	{
-		error = 0;
-		return Return_t::OK;
+		doneCallback(status);
 	}
-
-	return Return_t::NOK;
 }
 
 
@@ -218,9 +462,43 @@ extern "C"
 			error = 1;
 			_PRINTF_ERROR("TWI error %u\n", nrf_twim_errorsrc_get_and_clear(NRF_TWIM0));
 			nrf_twim_event_clear(NRF_TWIM0, NRF_TWIM_EVENT_ERROR);
+
+			// STOPPED event will finish the transfer
 			nrf_twim_task_trigger(NRF_TWIM0, NRF_TWIM_TASK_STOP);
-		}		
-	}	
+		}
+
+		// List job is finished by TIMER1
+		if (!listActive && nrf_twim_event_check(NRF_TWIM0, NRF_TWIM_EVENT_STOPPED))
+		{
+			finish();
+		}
+	}
+
+	/**
+	 * @brief TIMER1 interrupt handler.
+	 * 
+	 * Last list transaction is done.
+	 * 
+	 * @return No return value.
+	 */
+	void TIMER1_IRQHandler(void)
+	{
+		sd_nvic_ClearPendingIRQ(TIMER1_IRQn);
+
+		if (nrf_timer_event_check(NRF_TIMER1, NRF_TIMER_EVENT_COMPARE1))
+		{
+			nrf_timer_event_clear(NRF_TIMER1, NRF_TIMER_EVENT_COMPARE1);
+			nrf_timer_task_trigger(NRF_TIMER1, NRF_TIMER_TASK_STOP);
+
+			nrf_twim_tx_list_disable(NRF_TWIM0);
+			nrf_twim_rx_list_disable(NRF_TWIM0);
+			nrf_twim_event_clear(NRF_TWIM0, NRF_TWIM_EVENT_STOPPED);
+			nrf_twim_int_enable(NRF_TWIM0, NRF_TWIM_INT_STOPPED_MASK);
+			listActive = 0;
+
+			finish();
+		}
+	}
 };
 
 
@@ -0,0 +1,412 @@
+/**
+ * @file Timer.cpp
+ * @author silvio3105 (www.github.com/silvio3105)
+ * @brief Software timer module source file.
+ * 
+ * @copyright Copyright (c) 2025, silvio3105
+ * 
+ */
+
+/*
+	Copyright (c) 2025, silvio3105 (www.github.com/silvio3105)
+
+	Access and use of this Project and its contents are granted free of charge to any Person.
+	The Person is allowed to copy, modify and use The Project and its contents only for non-commercial use.
+	Commercial use of this Project and its contents is prohibited.
+	Modifying this License and/or sublicensing is prohibited.
+
+	THE PROJECT AND ITS CONTENT ARE PROVIDED "AS IS" WITH ALL FAULTS AND WITHOUT EXPRESSED OR IMPLIED WARRANTY.
+	THE AUTHOR KEEPS ALL RIGHTS TO CHANGE OR REMOVE THE CONTENTS OF THIS PROJECT WITHOUT PREVIOUS NOTICE.
+	THE AUTHOR IS NOT RESPONSIBLE FOR DAMAGE OF ANY KIND OR LIABILITY CAUSED BY USING THE CONTENTS OF THIS PROJECT.
+
+	This License shall be included in all functional textual files.
+*/
+
+// ----- INCLUDE FILES
+#include			"Timer.hpp"
+
+#include			"nrf.h"
+#include			"nrf_rtc.h"
+#include			"nrf_nvic.h"
+#include 			"app_error.h"
+#include			"app_util_platform.h"
+
+
+/**
+ * @addtogroup Timer
+ * 
+ * Tickless software timer module. \c RTC2 runs free at \ref Timer::tickRate and is never cleared.
+ * Each scheduler event has one one-shot or periodic timer which posts the event when it expires.
+ * Active timers are kept in queue sorted by deadline, four earliest deadlines are loaded into \c RTC2 compare channels.
+ * Periodic timers which expire within \ref AppConfig::timerSlack of other timer are handled in the same wakeup.
+ * One-shot timers never expire early.
+ * @{
+ */
+
+// ----- STRUCTS
+/**
+ * @brief Software timer descriptor.
+ * 
+ */
+struct Timer_s
+{
+	uint32_t deadline; /**< @brief Expiry tick. */
+	uint32_t period; /**< @brief Reload period in ticks. \c 0 for one-shot timer. */
+	uint8_t next; /**< @brief Index of next timer in queue. */
+	uint8_t active; /**< @brief Set to \c 1 while timer is in queue. */
+};
+
+
+// ----- VARIABLES
+static constexpr uint8_t none = (uint8_t)Scheduler::Event_t::Count; /**< @brief End of queue marker. */
+static constexpr uint8_t channels = 4; /**< @brief Number of \c RTC2 compare channels. */
+static constexpr uint32_t counterRange = (1 << 24); /**< @brief \c RTC2 counter range in ticks. */
+static constexpr uint32_t slack = ((uint32_t)AppConfig::timerSlack * Timer::tickRate) / 1000; /**< @brief Timer slack in ticks. */
+static Timer_s timers[(uint8_t)Scheduler::Event_t::Count]; /**< @brief Timer for each scheduler event. */
+static uint8_t head = none; /**< @brief Index of timer with earliest deadline. */
+static volatile uint32_t overflows = 0; /**< @brief Number of \c RTC2 counter overflows. */
+static_assert(32768 % Timer::tickRate == 0, "Timer tick rate must divide LFCLK frequency");
+
+
+// ----- STATIC FUNCTION DECLARATIONS
+static uint32_t now(void);
+static inline uint32_t toTicks(const uint32_t ms);
+static void enqueue(const uint8_t id);
+static void dequeue(const uint8_t id);
+static void arm(void);
+static void expire(void);
+
+
+// ----- NAMESPACES
+/**
+ * @brief Software timer module namespace.
+ * 
+ */
+namespace Timer
+{
+	// ----- FUNCTION DEFINITIONS
+	/**
+	 * @brief Init and start free running \c RTC2.
+	 * 
+	 * @return \c Return_t::NOK on fail.
+	 * @return \c Return_t::OK on success.
+	 */
+	Return_t init(void)
+	{
+		head = none;
+		for (uint8_t i = 0; i < none; i++)
+		{
+			timers[i].active = 0;
+		}
+
+		ret_code_t ret = sd_nvic_SetPriority(RTC2_IRQn, 2);
+		if (ret != NRF_SUCCESS)
+		{
+			APP_ERROR_CHECK(ret);
+			return Return_t::NOK;
+		}
+
+		ret = sd_nvic_EnableIRQ(RTC2_IRQn);
+		if (ret != NRF_SUCCESS)
+		{
+			APP_ERROR_CHECK(ret);
+			return Return_t::NOK;
+		}
+
+		nrf_rtc_prescaler_set(NRF_RTC2, (32768 / tickRate) - 1); // ~1ms resolution
+		nrf_rtc_int_enable(NRF_RTC2, NRF_RTC_INT_OVERFLOW_MASK);
+		nrf_rtc_task_trigger(NRF_RTC2, NRF_RTC_TASK_CLEAR);
+		nrf_rtc_task_trigger(NRF_RTC2, NRF_RTC_TASK_START);
+
+		return Return_t::OK;
+	}
+
+	/**
+	 * @brief Start or restart timer.
+	 * 
+	 * @param event Event posted when timer expires. See \ref Scheduler::Event_t
+	 * @param delay Time in ms until first expiry.
+	 * @param period Reload period in ms. Set to \c 0 for one-shot timer.
+	 * 
+	 * @return No return value.
+	 * 
+	 * @note Periodic timer reloads from its deadline so it does not drift. Maximum \c delay and \c period is 9 hours.
+	 */
+	void start(const Scheduler::Event_t event, const uint32_t delay, const uint32_t period)
+	{
+		const uint8_t id = (uint8_t)event;
+
+		CRITICAL_REGION_ENTER();
+
+		if (timers[id].active)
+		{
+			dequeue(id);
+		}
+
+		timers[id].deadline = now() + toTicks(delay);
+		timers[id].period = toTicks(period);
+		enqueue(id);
+		arm();
+
+		CRITICAL_REGION_EXIT();
+	}
+
+	/**
+	 * @brief Stop timer.
+	 * 
+	 * @param event Timer event. See \ref Scheduler::Event_t
+	 * 
+	 * @return No return value.
+	 * 
+	 * @note Already posted event is not cancelled.
+	 */
+	void stop(const Scheduler::Event_t event)
+	{
+		const uint8_t id = (uint8_t)event;
+
+		CRITICAL_REGION_ENTER();
+
+		if (timers[id].active)
+		{
+			dequeue(id);
+			arm();
+		}
+
+		CRITICAL_REGION_EXIT();
+	}
+
+	/**
+	 * @brief Check if timer is running.
+	 * 
+	 * @param event Timer event. See \ref Scheduler::Event_t
+	 * 
+	 * @return \c 1 if timer is running, \c 0 otherwise.
+	 */
+	uint8_t isActive(const Scheduler::Event_t event)
+	{
+		return timers[(uint8_t)event].active;
+	}
+
+	/**
+	 * @brief Get current timer tick.
+	 * 
+	 * @return Ticks since \ref init in \ref tickRate units. Wraps around after ~48 days.
+	 */
+	uint32_t getTick(void)
+	{
+		return now();
+	}
+};
+
+
+// ----- STATIC FUNCTION DEFINITIONS
+/**
+ * @brief Get 32-bit tick from overflow counter and 24-bit \c RTC2 counter.
+ * 
+ * @return Current tick.
+ */
+static uint32_t now(void)
+{
+	uint32_t ovf;
+	uint32_t cnt;
+	uint32_t start;
+
+	do
+	{
+		start = overflows;
+		ovf = start;
+		cnt = nrf_rtc_counter_get(NRF_RTC2);
+
+		// Overflow is not handled yet when called with interrupts disabled
+		if (nrf_rtc_event_pending(NRF_RTC2, NRF_RTC_EVENT_OVERFLOW))
+		{
+			ovf++;
+			cnt = nrf_rtc_counter_get(NRF_RTC2);
+		}
+	}
+	while (start != overflows);
+
+	return (ovf << 24) | cnt;
+}
+
+/**
+ * @brief Convert ms to timer ticks.
+ * 
+ * @param ms Time in ms.
+ * 
+ * @return Time in ticks rounded up.
+ */
+static inline uint32_t toTicks(const uint32_t ms)
+{
+	return ((ms * (Timer::tickRate / 8)) + 124) / 125;
+}
+
+/**
+ * @brief Insert timer into queue sorted by deadline.
+ * 
+ * @param id Timer index.
+ * 
+ * @return No return value.
+ * 
+ * @note Timer with same deadline goes after already queued ones.
+ */
+static void enqueue(const uint8_t id)
+{
+	uint8_t* link = &head;
+	while (*link != none && (int32_t)(timers[*link].deadline - timers[id].deadline) <= 0)
+	{
+		link = &timers[*link].next;
+	}
+
+	timers[id].next = *link;
+	timers[id].active = 1;
+	*link = id;
+}
+
+/**
+ * @brief Remove timer from queue.
+ * 
+ * @param id Timer index.
+ * 
+ * @return No return value.
+ */
+static void dequeue(const uint8_t id)
+{
+	uint8_t* link = &head;
+	while (*link != none && *link != id)
+	{
+		link = &timers[*link].next;
+	}
+
+	if (*link == id)
+	{
+		*link = timers[id].next;
+	}
+	timers[id].active = 0;
+}
+
+/**
+ * @brief Load earliest deadlines into \c RTC2 compare channels.
+ * 
+ * Deadlines within timer slack of already loaded one share its channel.
+ * Deadlines out of counter range are loaded after counter overflow.
+ * 
+ * @return No return value.
+ */
+static void arm(void)
+{
+	const uint32_t tick = now();
+	uint32_t last = 0;
+	uint8_t channel = 0;
+
+	for (uint8_t id = head; id != none && channel < channels; id = timers[id].next)
+	{
+		uint32_t deadline = timers[id].deadline;
+
+		// Compare does not trigger for values less than 2 ticks ahead of counter
+		if ((int32_t)(deadline - (tick + 2)) < 0)
+		{
+			deadline = tick + 2;
+		}
+
+		if (deadline - tick >= counterRange)
+		{
+			break;
+		}
+
+		// One-shot timers are not fired early, so they always need own channel
+		if (channel && timers[id].period && deadline - last <= slack)
+		{
+			continue;
+		}
+
+		nrf_rtc_event_clear(NRF_RTC2, nrf_rtc_compare_event_get(channel));
+		nrf_rtc_cc_set(NRF_RTC2, channel, deadline & (counterRange - 1));
+		nrf_rtc_int_enable(NRF_RTC2, RTC_CHANNEL_INT_MASK(channel));
+
+		last = deadline;
+		channel++;
+	}
+
+	for (; channel < channels; channel++)
+	{
+		nrf_rtc_int_disable(NRF_RTC2, RTC_CHANNEL_INT_MASK(channel));
+	}
+}
+
+/**
+ * @brief Post events of expired timers and reload periodic ones.
+ * 
+ * @return No return value.
+ */
+static void expire(void)
+{
+	const uint32_t tick = now();
+	uint8_t id = head;
+
+	while (id != none && (int32_t)(timers[id].deadline - (tick + slack)) <= 0)
+	{
+		const uint8_t next = timers[id].next;
+
+		// Only periodic timers may fire early, one-shot delays must not be cut short
+		if ((int32_t)(timers[id].deadline - tick) > 0 && !timers[id].period)
+		{
+			id = next;
+			continue;
+		}
+
+		dequeue(id);
+		Scheduler::post((Scheduler::Event_t)id);
+
+		if (timers[id].period)
+		{
+			timers[id].deadline += timers[id].period;
+
+			// Skip missed periods instead of posting them in burst
+			if ((int32_t)(timers[id].deadline - tick) <= 0)
+			{
+				timers[id].deadline = tick + timers[id].period;
+			}
+
+			enqueue(id);
+		}
+
+		id = next;
+	}
+
+	arm();
+}
+
+
+// ----- INTERRUPTS
+extern "C"
+{
+	/**
+	 * @brief RTC2 interrupt handler.
+	 * 
+	 * @return No return value.
+	 */
+	void RTC2_IRQHandler(void)
+	{
+		_PRINT("RTC2 IRQ\n");
+		sd_nvic_ClearPendingIRQ(RTC2_IRQn);
+
+		if (nrf_rtc_event_pending(NRF_RTC2, NRF_RTC_EVENT_OVERFLOW))
+		{
+			nrf_rtc_event_clear(NRF_RTC2, NRF_RTC_EVENT_OVERFLOW);
+			overflows++;
+		}
+
+		for (uint8_t i = 0; i < channels; i++)
+		{
+			nrf_rtc_event_clear(NRF_RTC2, nrf_rtc_compare_event_get(i));
+		}
+
+		expire();
+	}
+}
+
+
+/** @} */
+
+// END WITH NEW LINE
@@ -0,0 +1,100 @@
+#!/usr/bin/env python3
+#
+# sTPMS authenticated payload verifier.
+#
+# Copyright (c) 2025, silvio3105 (www.github.com/silvio3105)
+#
+# Access and use of this Project and its contents are granted free of charge to any Person.
+# The Person is allowed to copy, modify and use The Project and its contents only for non-commercial use.
+# Commercial use of this Project and its contents is prohibited.
+# Modifying this License and/or sublicensing is prohibited.
+#
+# THE PROJECT AND ITS CONTENT ARE PROVIDED "AS IS" WITH ALL FAULTS AND WITHOUT EXPRESSED OR IMPLIED WARRANTY.
+# THE AUTHOR KEEPS ALL RIGHTS TO CHANGE OR REMOVE THE CONTENTS OF THIS PROJECT WITHOUT PREVIOUS NOTICE.
+# THE AUTHOR IS NOT RESPONSIBLE FOR DAMAGE OF ANY KIND OR LIABILITY CAUSED BY USING THE CONTENTS OF THIS PROJECT.
+#
+# This License shall be included in all functional textual files.
+#
+# Usage: AuthVerify.py <master key hex> <MAC AA:BB:CC:DD:EE:FF> <manufacturer data hex without company ID> [last counter] [last epoch]
+# Exit code is 0 for new valid payload, 1 for invalid tag and 2 for duplicate or replayed payload(counter not above last counter, or older epoch).
+# Requires "cryptography" package.
+
+import argparse
+import sys
+
+from cryptography.hazmat.primitives import cmac
+from cryptography.hazmat.primitives.ciphers import Cipher, algorithms, modes
+
+# Must match AppConfig::authTagSize
+TAG_SIZE = 4
+
+# Number of counter values searched forward from last counter
+WINDOW = 4096
+
+# Number of epochs searched forward from last epoch, epoch increases every time device loses power
+EPOCH_WINDOW = 4
+
+
+def deviceKey(masterKey, mac):
+	# MAC address is used in over-the-air byte order, LSB first
+	addr = bytes.fromhex(mac.replace(":", ""))[::-1]
+	encryptor = Cipher(algorithms.AES(masterKey), modes.ECB()).encryptor()
+	return encryptor.update(addr + bytes(16 - len(addr))) + encryptor.finalize()
+
+
+def tag(key, epoch, counter, payload):
+	c = cmac.CMAC(algorithms.AES(key))
+	c.update(epoch.to_bytes(4, "little") + counter.to_bytes(4, "little") + payload)
+	return c.finalize()[:TAG_SIZE]
+
+
+def verify(key, data, lastEpoch, last):
+	payload = data[:-(1 + TAG_SIZE)]
+	low = data[-(1 + TAG_SIZE)]
+	received = data[-TAG_SIZE:]
+
+	# Counter restarts from 0 in every new epoch, older epochs and counters are searched too so replays are reported
+	for epoch in range(max(lastEpoch - EPOCH_WINDOW, 0), lastEpoch + EPOCH_WINDOW + 1):
+		start = max(last - WINDOW, 0) if epoch == lastEpoch else 0
+		end = last + WINDOW if epoch <= lastEpoch else WINDOW
+
+		# Full counter is first value not below start counter with matching low byte
+		counter = (start & ~0xFF) | low
+		if counter < start:
+			counter += 0x100
+
+		while counter <= end:
+			if tag(key, epoch, counter, payload) == received:
+				return epoch, counter, payload
+			counter += 0x100
+
+	return None, None, payload
+
+
+def main():
+	parser = argparse.ArgumentParser(description = "Verify sTPMS authenticated payload")
+	parser.add_argument("key", help = "Fleet master key(AUTH_KEY) in hex")
+	parser.add_argument("mac", help = "Device MAC address")
+	parser.add_argument("data", help = "Manufacturer data in hex without company ID")
+	parser.add_argument("last", nargs = "?", type = int, default = 0, help = "Last accepted counter of this device")
+	parser.add_argument("epoch", nargs = "?", type = int, default = 0, help = "Last accepted epoch of this device")
+	args = parser.parse_args()
+
+	key = deviceKey(bytes.fromhex(args.key), args.mac)
+	epoch, counter, payload = verify(key, bytes.fromhex(args.data), args.epoch, args.last)
+
+	if counter is None:
+		print("FAIL: tag does not match")
+		return 1
+
+	# Equal counter is repeated frame from alarm burst, lower counter or older epoch is replay
+	if epoch < args.epoch or (epoch == args.epoch and counter <= args.last):
+		print("%s: epoch %u, counter %u, payload %s" % ("DUPLICATE" if (epoch == args.epoch and counter == args.last) else "REPLAY", epoch, counter, payload.hex()))
+		return 2
+
+	print("OK: epoch %u, counter %u, payload %s" % (epoch, counter, payload.hex()))
+	return 0
+
+
+if __name__ == "__main__":
+	sys.exit(main())